@@ -1,126 +1,430 @@
 #include "MapEditor.h"
 
-MapEditor::MapEditor(N5110 &lcd, Joystick &joystick, DigitalIn &select)
-    : lcd(lcd), joystick(joystick), selectButton(select) {
+// Drawn over floor the explorer can't get to from the start
+static const unsigned char UNREACHABLE_MARK[TILE_SIZE] = { 0, 0, 0x14, 0x08, 0x14, 0, 0, 0 };
+
+static char const *const TOOL_NAMES[TOOL_COUNT] = { "Pen", "Line", "Box", "Fill" };
+
+MapEditor::MapEditor(MapStore &maps)
+    : Scene("Editor"), map(nullptr), incoming(nullptr), overview(nullptr), fillRuns(nullptr), maps(maps) { }
+
+void MapEditor::enter() {
     cursorX = 0;
     cursorY = 0;
+    cursorMoveX.reset();
+    cursorMoveY.reset();
     selectedTile = 1;
+    tileBeforeSelect = 1;
+    tool = TOOL_PEN;
+    dragging = false;
+    editLeft = MAP_WIDTH;
+    editRight = -1;
+    gestured = false;
+    lastD = CENTRE;
+    memset(shape, 0, sizeof(shape));
     viewportX = 0;
     viewportY = 0;
+    pressDuration = 0;
+    minimap = false;
+    redraw = true;
 
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        for (int x = 0; x < MAP_WIDTH; x++) {
-            map[y][x] = 0;
-        }
+    // zero-filled, i.e. all TILE_EMPTY
+    map = arena().array<TileMap>(1);
+    incoming = arena().array<TileMap>(1);
+    overview = arena().array<uint8_t>(MAP_WIDTH);  // blank, like the map
+    world.attach(map);
+    if (maps.load(MBED_CONF_APP_MAP_SLOT, *incoming)) {
+        *map = *incoming;
+        rebuildOverview();
     }
+    reach.init(arena(), MAP_WIDTH, EXPLORE_CLIMB);  // floor the explorer's jump can't get to
+    findReach();
+    anims.init(arena());
+    undo.init(arena(), MBED_CONF_APP_EDITOR_UNDO_ENTRIES);
+    fillRuns = arena().array<uint16_t>(FILL_RUNS);
 }
 
-void MapEditor::run() {
-    while (true) {
-        update();
-        drawMap();
-        drawCursor();
-        drawTileSelector();
-        lcd.refresh();
-        ThisThread::sleep_for(100ms);
-    }
+void MapEditor::exit() {
+    if (dragging) finishTool(false);
+    maps.save(MBED_CONF_APP_MAP_SLOT, *map);
 }
 
-void MapEditor::update() {
-    Direction d = joystick.get_direction();
+void MapEditor::update(InputFrame const &in, uint8_t pressed) {
+    int oldX = cursorX, oldY = cursorY, oldTile = selectedTile;
+    int oldCell = map->get(cursorX, cursorY);
+    bool oldFast = cursorMoveX.fast() || cursorMoveY.fast();
 
-    if (d == N && cursorY > 0) cursorY--;
-    else if (d == S && cursorY < MAP_HEIGHT - 1) cursorY++;
-    else if (d == E && cursorX < MAP_WIDTH - 1) cursorX++;
-    else if (d == W && cursorX > 0) cursorX--;
+    Direction d = in.d;
+    bool selectHeld = in.buttons & BUTTON_SELECT;
 
-    if (joystick.button_pressed()) {
-        map[cursorY][cursorX] = selectedTile;
+    // With select held on its own on the tile view the stick makes gestures instead of
+    // moving: a flick left or right undoes or redoes, up or down picks the tool.
+    // The select press has already cycled the tile, so that is put back.
+    if (selectHeld && !minimap && !(in.buttons & BUTTON_JOY)) {
+        cursorMoveX.reset();
+        cursorMoveY.reset();
+        if (d != CENTRE && lastD == CENTRE && gesture(d)) {
+            gestured = true;
+            selectedTile = tileBeforeSelect;
+        }
+    } else {
+        // Speed follows how far the stick is pushed and ramps up the longer it is
+        // held, ending in fast travel after a couple of seconds at full tilt
+        cursorX += cursorMoveX.step(DIRECTION_DX[d], in.mag, MOVE_ROW_FAST);
+        cursorY += cursorMoveY.step(DIRECTION_DY[d], in.mag, MOVE_ROW_FAST);
     }
+    lastD = d;
+    if (cursorX < 0) cursorX = 0;
+    if (cursorX > MAP_WIDTH - 1) cursorX = MAP_WIDTH - 1;
+    if (cursorY < 0) cursorY = 0;
+    if (cursorY > MAP_HEIGHT - 1) cursorY = MAP_HEIGHT - 1;
 
-    if (selectButton.read() == 0) {
+    // Hold the stick button and press select to open or close the minimap;
+    // select on its own also closes it
+    bool oldMinimap = minimap;
+    if ((pressed & BUTTON_SELECT) && ((in.buttons & BUTTON_JOY) || minimap)) {
+        minimap = !minimap;
+    } else if (pressed & BUTTON_SELECT) {
+        // Cycle tile on the press, rather than blocking until select is released
+        tileBeforeSelect = selectedTile;
         selectedTile = (selectedTile + 1) % TILE_TYPE_COUNT;
-        while (selectButton.read() == 0) ThisThread::sleep_for(50ms);
     }
 
-    // Export if user long-presses select
-    static int pressDuration = 0;
-    if (selectButton.read() == 0) {
+    // The pen paints as it goes; the other tools show what they would set while
+    // the stick button is held and set it when it is let go
+    if (minimap) {
+        if (dragging) finishTool(false);
+    } else if (pressed & BUTTON_JOY) {
+        startTool();
+    } else if (dragging && !(in.buttons & BUTTON_JOY)) {
+        finishTool(true);
+    } else if (dragging && (cursorX != oldX || cursorY != oldY)) {
+        shapeTool();
+    }
+
+    // Export if user long-presses select, keep holding to go back to the menu
+    if (selectHeld && gestured) {
+        pressDuration = 0;
+    } else if (selectHeld) {
         pressDuration++;
-        if (pressDuration > 30) {
+        if (pressDuration == EXPORT_PRESS_FRAMES) {
             exportMap();
-            pressDuration = 0;
+        } else if (pressDuration == 2 * EXPORT_PRESS_FRAMES) {
+            change(SCENE_MENU);
         }
     } else {
         pressDuration = 0;
+        gestured = false;
     }
+
+    bool fast = cursorMoveX.fast() || cursorMoveY.fast();
+    // only redraw for animation when a tile on screen has moved on a frame
+    if (anims.tick() && !minimap && animatedOnScreen()) redraw = true;
+
+    redraw |= cursorX != oldX || cursorY != oldY || selectedTile != oldTile ||
+              map->get(oldX, oldY) != oldCell || fast != oldFast || minimap != oldMinimap;
 }
 
-void MapEditor::drawMap() {
-    lcd.clear();
+void MapEditor::draw(N5110 &lcd) {
+    if (minimap) {
+        drawMinimap(lcd);
+    } else {
+        drawMap(lcd);
+        drawCursor(lcd);
+        drawTileSelector(lcd);
+    }
+    redraw = false;
+}
+
+bool MapEditor::dirty() const { return redraw; }
+
+bool MapEditor::console(uint8_t byte) {
+    if (!link.takes(byte)) return false;
+    importMap(link.push(byte, *incoming));
+    return true;
+}
+
+void MapEditor::followCursor() {
     viewportX = cursorX - 5;
     viewportY = cursorY - 2;
     if (viewportX < 0) viewportX = 0;
     if (viewportY < 0) viewportY = 0;
     if (viewportX > MAP_WIDTH - 10) viewportX = MAP_WIDTH - 10;
     if (viewportY > MAP_HEIGHT - 4) viewportY = MAP_HEIGHT - 4;
+}
+
+void MapEditor::drawMap(N5110 &lcd) {
+    lcd.clear();
+    followCursor();
 
     for (int row = 0; row < 4; row++) {
         for (int col = 0; col < 10; col++) {
-            int mapX = viewportX + col;
-            int mapY = viewportY + row;
-            int tile = map[mapY][mapX];
-            int px = col * TILE_SIZE;
-            int py = row * TILE_SIZE + 8;
-            switch (tile) {
-                case 1:
-                    lcd.drawLine(px, py + 7, px + 7, py + 7, FILL_BLACK);
-                    break;
-                case 2:
-                    lcd.drawRect(px + 1, py + 5, 6, 3, FILL_BLACK);
-                    break;
-                case 3:
-                    lcd.drawRect(px, py, 8, 8, FILL_BLACK);
-                    break;
-                case 4:
-                    lcd.drawLine(px, py + 4, px + 7, py + 4, FILL_BLACK);
-                    break;
-                case 5:
-                    lcd.setPixel(px + 3, py + 2);
-                    lcd.setPixel(px + 4, py + 3);
-                    break;
-                default:
-                    break;
+            int x = viewportX + col, y = viewportY + row;
+            if ((shape[y] >> x) & 1) {
+                drawTileDimmed(lcd, anims.image(selectedTile, x, y), col, row);
+            } else if (reach.standing(x, y) && !reach.reachable(x, y)) {
+                lcd.blitBank(col * TILE_SIZE, TILE_FIRST_BANK + row, UNREACHABLE_MARK, TILE_SIZE);
+            } else {
+                drawTile(lcd, anims.image(map->get(x, y), x, y), col, row);
             }
         }
     }
 }
 
-void MapEditor::drawCursor() {
-    int cx = (cursorX - viewportX) * TILE_SIZE;
-    int cy = (cursorY - viewportY) * TILE_SIZE + 8;
-    lcd.drawRect(cx, cy, TILE_SIZE, TILE_SIZE, FILL_TRANSPARENT);
+// The tile under the cursor is shown inverted, so it stays visible on walls
+void MapEditor::drawCursor(N5110 &lcd) {
+    unsigned char inverted[TILE_SIZE];
+    unsigned char const *tile = TILE_ATLAS[anims.image(map->get(cursorX, cursorY), cursorX, cursorY)];
+    for (int i = 0; i < TILE_SIZE; i++) inverted[i] = ~tile[i];
+    lcd.blitBank((cursorX - viewportX) * TILE_SIZE, TILE_FIRST_BANK + cursorY - viewportY,
+                 inverted, TILE_SIZE);
 }
 
-void MapEditor::drawTileSelector() {
-    const char* tileNames[] = {
-        "Empty", "Wall", "Habitat", "Rover", "Crater", "Terminal"
-    };
+void MapEditor::drawTileSelector(N5110 &lcd) {
     char buf[17];
-    sprintf(buf, "Tile: %s", tileNames[selectedTile]);
+    bool fast = cursorMoveX.fast() || cursorMoveY.fast();
+    if (fast) {
+        sprintf(buf, ">> %s", TILE_PROPS[selectedTile].name);
+    } else {
+        sprintf(buf, "%s %s", TOOL_NAMES[tool], TILE_PROPS[selectedTile].name);
+    }
     lcd.printString(buf, 0, 0);
 }
 
 
+// The overview is kept up to date tile by tile, so showing it is one bank copy.
+// The window the tile view would show is marked under the map and to its left,
+// and the cursor by a tick above it and its own pixel inverted.
+void MapEditor::drawMinimap(N5110 &lcd) {
+    lcd.clear();
+    followCursor();
+    int top = MINIMAP_BANK * 8;
+
+    lcd.printString("Map", 0, 0);
+    lcd.blitBank(MINIMAP_X, MINIMAP_BANK, overview, MAP_WIDTH);
+    lcd.drawRect(MINIMAP_X - 1, top - 1, MAP_WIDTH + 2, MAP_HEIGHT + 2, FILL_TRANSPARENT);
+
+    lcd.drawLine(MINIMAP_X + viewportX, top + MAP_HEIGHT + 2, MINIMAP_X + viewportX + 9, top + MAP_HEIGHT + 2, FILL_BLACK);
+    lcd.drawLine(MINIMAP_X - 3, top + viewportY, MINIMAP_X - 3, top + viewportY + 3, FILL_BLACK);
+
+    lcd.setPixel(MINIMAP_X + cursorX, top - 3, true);
+    lcd.setPixel(MINIMAP_X + cursorX, top + cursorY, !lcd.getPixel(MINIMAP_X + cursorX, top + cursorY));
+
+    char buf[15];
+    sprintf(buf, "x%d y%d", cursorX, cursorY);
+    lcd.printString(buf, 0, 5);
+}
+
+// Sent as framed binary over the console; tools/mapconv.py turns it into level
+// art or a C array. It is saved to the map's slot too, as it would be on exit.
 void MapEditor::exportMap() {
-    printf("int map[%d][%d] = {\n", MAP_HEIGHT, MAP_WIDTH);
+    int bytes = link.send(*map);
+    bool saved = maps.save(MBED_CONF_APP_MAP_SLOT, *map);
+    printf("Map exported, %d bytes%s\n", bytes, saved ? ", saved" : "");
+}
+
+// A map pushed from tools/mapconv.py replaces the one being edited
+void MapEditor::importMap(MapLink::Import result) {
+    if (result == MapLink::IMPORT_DONE) {
+        if (dragging) finishTool(false);
+        *map = *incoming;
+        rebuildOverview();
+        findReach();
+        undo.clear();
+        redraw = true;
+        printf("Map imported\n");
+    } else if (result == MapLink::IMPORT_FAILED) {
+        printf("Map import failed\n");
+    }
+}
+
+// Flood the whole map from the start; edits after this only repair it
+void MapEditor::findReach() {
+    reach.begin(world, 0);
+    reach.goal(MAP_START_X, MAP_START_Y);
+    reach.build();
+}
+
+bool MapEditor::animatedOnScreen() const {
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 10; col++) {
+            int x = viewportX + col, y = viewportY + row;
+            if (anims.changed(map->get(x, y), x, y)) return true;
+        }
+    }
+    return false;
+}
+
+// Every edit goes through here, so the overview stays current and reach is
+// repaired by finishEdit() once the edit is done
+void MapEditor::setTile(int x, int y, uint8_t tile) {
+    if (!world.set(x, y, tile)) return;
+    if (tile == TILE_EMPTY) {
+        overview[x] &= ~(1 << y);
+    } else {
+        overview[x] |= 1 << y;
+    }
+    if (x < editLeft) editLeft = x;
+    if (x > editRight) editRight = x;
+}
+
+// A repair per column is cheaper for a dab or a short line, but a big shape
+// touches enough of the map that one flood from the start beats them all
+void MapEditor::finishEdit() {
+    if (editLeft > editRight) return;
+    if (editRight - editLeft < 3) {
+        for (int x = editLeft; x <= editRight; x++) reach.repair(world, x);
+    } else {
+        findReach();
+    }
+    editLeft = MAP_WIDTH;
+    editRight = -1;
+    redraw = true;
+}
+
+bool MapEditor::gesture(Direction d) {
+    Callback<void(int, int, uint8_t)> put = callback(this, &MapEditor::setTile);
+    if (d == W) {
+        if (undo.undo(put)) finishEdit();
+    } else if (d == E) {
+        if (undo.redo(put)) finishEdit();
+    } else if (d == N) {
+        tool = (EditTool)((tool + TOOL_COUNT - 1) % TOOL_COUNT);
+    } else if (d == S) {
+        tool = (EditTool)((tool + 1) % TOOL_COUNT);
+    } else {
+        return false;
+    }
+    redraw = true;
+    return true;
+}
+
+void MapEditor::startTool() {
+    anchorX = cursorX;
+    anchorY = cursorY;
+    dragging = true;
+    if (tool == TOOL_PEN) {
+        undo.begin(selectedTile);
+    }
+    shapeTool();
+}
+
+// The pen sets tiles straight away, a stroke being one undo step: its anchor
+// follows the cursor, so a line from it covers every tile the cursor skipped
+// over in a fast move. The others redo their outline from the anchor to the
+// cursor.
+void MapEditor::shapeTool() {
+    memset(shape, 0, sizeof(shape));
+    if (tool == TOOL_PEN) {
+        lineShape();
+        applyShape();
+        memset(shape, 0, sizeof(shape));
+        anchorX = cursorX;
+        anchorY = cursorY;
+        return;
+    }
+    if (tool == TOOL_LINE) {
+        lineShape();
+    } else if (tool == TOOL_BOX) {
+        boxShape();
+    } else {
+        fillShape();
+    }
+    redraw = true;
+}
+
+void MapEditor::finishTool(bool apply) {
+    dragging = false;
+    if (tool == TOOL_PEN) {
+        undo.end();
+    } else if (apply) {
+        undo.begin(selectedTile);
+        applyShape();
+        undo.end();
+    }
+    memset(shape, 0, sizeof(shape));
+    redraw = true;
+}
+
+// Bresenham, so it is a tile thick and joined at the corners
+void MapEditor::lineShape() {
+    int dx = abs(cursorX - anchorX), sx = anchorX < cursorX ? 1 : -1;
+    int dy = -abs(cursorY - anchorY), sy = anchorY < cursorY ? 1 : -1;
+    int err = dx + dy;
+    int x = anchorX, y = anchorY;
+    while (true) {
+        shape[y] |= 1ull << x;
+        if (x == cursorX && y == cursorY) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y += sy;
+        }
+    }
+}
+
+void MapEditor::boxShape() {
+    int left = anchorX < cursorX ? anchorX : cursorX, right = anchorX < cursorX ? cursorX : anchorX;
+    int top = anchorY < cursorY ? anchorY : cursorY, bottom = anchorY < cursorY ? cursorY : anchorY;
+    uint64_t row = ((2ull << right) - 1) & ~((1ull << left) - 1);
+    for (int y = top; y <= bottom; y++) shape[y] = row;
+}
+
+// Scanline fill of the tiles joined to the cursor's that match it. Each run of
+// them along a row is marked whole as soon as it is found, then listed to look
+// above and below; as a run is only ever found once the list is bounded by how
+// many runs the map can hold, and every tile is looked at a few times at most.
+void MapEditor::fillShape() {
+    uint8_t target = map->get(cursorX, cursorY);
+    if (target == selectedTile) return;
+
+    int runs = 0;
+    fillRun(cursorX, cursorY, target, runs);
+    while (runs > 0) {
+        uint16_t run = fillRuns[--runs];
+        int y = run >> 12, left = (run >> 6) & 0x3F, right = run & 0x3F;
+        for (int ny = y - 1; ny <= y + 1; ny += 2) {
+            if (ny < 0 || ny >= MAP_HEIGHT) continue;
+            for (int x = left; x <= right; x++) {
+                if (!((shape[ny] >> x) & 1) && map->get(x, ny) == target) fillRun(x, ny, target, runs);
+            }
+        }
+    }
+}
+
+void MapEditor::fillRun(int x, int y, uint8_t target, int &runs) {
+    int left = x, right = x;
+    while (left > 0 && map->get(left - 1, y) == target) left--;
+    while (right < MAP_WIDTH - 1 && map->get(right + 1, y) == target) right++;
+    shape[y] |= ((2ull << right) - 1) & ~((1ull << left) - 1);
+    fillRuns[runs++] = (y << 12) | (left << 6) | right;
+}
+
+// Sets the shape's tiles to the selected one, each change going in the undo log
+void MapEditor::applyShape() {
     for (int y = 0; y < MAP_HEIGHT; y++) {
-        printf("  {");
         for (int x = 0; x < MAP_WIDTH; x++) {
-            printf("%d", map[y][x]);
-            if (x < MAP_WIDTH - 1) printf(",");
+            if (!((shape[y] >> x) & 1)) continue;
+            uint8_t old = map->get(x, y);
+            if (old == selectedTile) continue;
+            undo.record(x, y, old);
+            setTile(x, y, selectedTile);
         }
-        printf("}%s\n", y < MAP_HEIGHT - 1 ? "," : "");
     }
-    printf("};\n");
-}
\ No newline at end of file
+    finishEdit();
+}
+
+// A whole new map, e.g. an import
+void MapEditor::rebuildOverview() {
+    for (int x = 0; x < MAP_WIDTH; x++) {
+        uint8_t column = 0;
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            if (map->get(x, y) != TILE_EMPTY) column |= 1 << y;
+        }
+        overview[x] = column;
+    }
+}
@@ -3,33 +3,102 @@
 
 #include "mbed.h"
 #include "N5110.h"
-#include "Joystick.h"
+#include "MoveCurve.h"
+#include "Scene.h"
+#include "TileMap.h"
+#include "MapLink.h"
+#include "FlowField.h"
+#include "TileAnimator.h"
+#include "UndoLog.h"
+#include "MapStore.h"
+#include "games.h"
 
-#define MAP_WIDTH 60
-#define MAP_HEIGHT 10
-#define TILE_SIZE 8
-#define TILE_TYPE_COUNT 6  // Update if you add more tiles
+// Room for more than a whole-map fill, so any one edit can be undone
+#ifndef MBED_CONF_APP_EDITOR_UNDO_ENTRIES
+#define MBED_CONF_APP_EDITOR_UNDO_ENTRIES 512
+#endif
 
-class MapEditor {
+// The slot the editor keeps its map in, and the explorer can load
+#ifndef MBED_CONF_APP_MAP_SLOT
+#define MBED_CONF_APP_MAP_SLOT 0
+#endif
+
+// Hold select this many ticks to export the map, and twice as long to leave
+#define EXPORT_PRESS_FRAMES 30
+
+// The minimap: one pixel per tile, the whole map in one display bank
+#define MINIMAP_X 12
+#define MINIMAP_BANK 2
+
+static_assert(MAP_HEIGHT <= 8, "the minimap is one display bank");
+
+// A fill works through runs of tiles in a row, each packed as row, left, right
+static_assert(MAP_HEIGHT <= 8 && MAP_WIDTH <= 64, "a run is 3 + 6 + 6 bits");
+
+// Every run a fill can list at once: at most one in every other column of a row
+#define FILL_RUNS (MAP_HEIGHT * (MAP_WIDTH + 1) / 2)
+
+enum EditTool { TOOL_PEN, TOOL_LINE, TOOL_BOX, TOOL_FILL, TOOL_COUNT };
+
+class MapEditor : public Scene {
 public:
-    MapEditor(N5110 &lcd, Joystick &joystick, DigitalIn &select);
-    void run();
+    MapEditor(MapStore &maps);
+
+    void enter() override;  // carries on with the map in its slot, or starts a blank one
+    void exit() override;   // saves the map to its slot
+    void update(InputFrame const &in, uint8_t pressed) override;
+    void draw(N5110 &lcd) override;
+    bool console(uint8_t byte) override;  // map frames pushed from tools/mapconv.py
+    bool dirty() const override;
 
 private:
-    void drawMap();
-    void drawCursor();
-    void drawTileSelector();
-    void update();
+    void followCursor();
+    void drawMap(N5110 &lcd);
+    void drawMinimap(N5110 &lcd);
+    void drawCursor(N5110 &lcd);
+    void drawTileSelector(N5110 &lcd);
     void exportMap();
+    void importMap(MapLink::Import result);
+    void findReach();
+    void setTile(int x, int y, uint8_t tile);
+    void finishEdit();
+    void startTool();
+    void shapeTool();
+    void finishTool(bool apply);
+    void lineShape();
+    void boxShape();
+    void fillShape();
+    void fillRun(int x, int y, uint8_t target, int &runs);
+    void applyShape();
+    bool gesture(Direction d);
+    void rebuildOverview();
+    bool animatedOnScreen() const;
 
-    N5110 &lcd;
-    Joystick &joystick;
-    DigitalIn &selectButton;
-
-    int map[MAP_HEIGHT][MAP_WIDTH];
+    TileMap *map;      // in the scene arena
+    TileMap *incoming; // an import being received, kept only if it arrives intact
+    uint8_t *overview; // MAP_WIDTH columns, bit y set where tile y isn't empty
+    TileMapWorld world;  // the map as the explorer would walk it
+    FlowField reach;     // from the explorer's start, repaired as tiles change
+    TileAnimator anims;
+    UndoLog undo;
+    uint16_t *fillRuns; // FILL_RUNS runs waiting to spread, in the scene arena
+    uint64_t shape[MAP_HEIGHT];  // bit x of row y set for tiles the tool will set
+    MapLink link;
+    MapStore &maps;
     int cursorX, cursorY;
+    MoveAxis cursorMoveX, cursorMoveY;  // analog cursor speed with acceleration
     int selectedTile;
+    EditTool tool;
+    int anchorX, anchorY;   // where the stick button went down; for the pen, the last tile painted
+    bool dragging;          // the stick button is held with a tool in use
+    int editLeft, editRight;  // columns changed since reach was last repaired
+    int tileBeforeSelect;   // put back if holding select turns out to be a gesture
+    bool gestured;          // a gesture was made while select has been held
+    Direction lastD;
     int viewportX, viewportY;
+    int pressDuration;
+    bool minimap;  // showing the whole map rather than the tiles round the cursor
+    bool redraw;   // the map, cursor or tile selection changed
 };
 
 #endif
\ No newline at end of file
@@ -1,238 +1,425 @@
 #include "mbed.h"
 #include "N5110.h"
-#include "Joystick.h"
 #include "games.h"
+#include "MoveCurve.h"
+#include "Log.h"
+
+// The explorer's world: a level read in place from flash, a map saved from the
+// editor, or chunks made or decompressed a few at a time
+#if MBED_CONF_APP_EXPLORE_WORLD == 3
+static FlashLevel landing(LANDING_LEVEL);  // while the slot is empty
+static TileMapWorld saved;
+#elif MBED_CONF_APP_EXPLORE_WORLD == 2
+static FlashLevel landing(LANDING_LEVEL);
+#elif MBED_CONF_APP_EXPLORE_WORLD == 1
+static TerrainGenerator terrain(MBED_CONF_APP_WORLD_SEED);
+static ChunkCache chunks;
+#else
+static FlashChunkSource marsSource(MARS_WORLD, MARS_WORLD_SIZE);
+static ChunkCache chunks;
+#endif
+static TileWorld *world;
+static TileAnimator tileAnims;
+static int heading = 1;  // last direction walked, for prefetching
+
+// Dark Mars: only what the player can see is drawn, and what they have seen dimmed
+static const int SIGHT_RADIUS = 6;
+static const int EXPLORED_COLUMNS = 128;  // remembered around the player
+static FieldOfView sight;
+
+enum Shade { SHADE_HIDDEN, SHADE_REMEMBERED, SHADE_VISIBLE };
+
+static const unsigned char UNSEEN[TILE_SIZE] = { 0 };
+
+static Shade shade(int x, int y) {
+#if MBED_CONF_APP_EXPLORE_DARK
+    if (sight.visible(x, y)) return SHADE_VISIBLE;
+    return sight.explored(x, y) ? SHADE_REMEMBERED : SHADE_HIDDEN;
+#else
+    return SHADE_VISIBLE;
+#endif
+}
 
-// Global variables for map exploration.
-int map[MAP_HEIGHT][MAP_WIDTH] = { 0 };
-int playerX = 2;
-int playerY = 6;
-int playerYOffset = 0;
+// Rovers: parked rover tiles near the player wake up and drive after them, or
+// home to a habitat when there is no way to the player. They all steer by two
+// flow fields over a window of columns that follows the player.
+static const int ROVER_COLUMNS = 32;
+static const int ROVER_WINDOW_STEP = ROVER_COLUMNS / 4;  // the window moves this far at a time
+static const int ROVER_CLIMB = 1;                        // tiles a rover gets up
+static const int ROVER_SPEED = 1;                        // pixels per frame
+
+struct Rover {
+    int32_t x;          // tile it is leaving
+    int8_t y, nextY;
+    int8_t dir;         // 0 while stopped
+    uint8_t travelled;  // pixels towards the next tile
+    int32_t homeX;      // the rover tile it woke from
+    int8_t homeY;
+};
+
+static FlowField chase;  // to the player
+static FlowField home;   // to the floor beside any habitat
+static Rover *rovers;
+static int roverCount;
+static int windowLeft;      // first column of both fields, -1 before the first steer
+static int chaseX, chaseY;  // the player's tile when chase was built
+
+// The sky behind the tiles: stars, far ridges and nearer hills, each moving
+// less than the tiles the further off it is
+static constexpr ParallaxStrip<64> SKY_STARS = star_strip<64>(0x3A25, 70, 0, 30);
+static constexpr ParallaxStrip<128> SKY_RIDGES = ridge_strip<128>(0x3A26, 16, 14, 26);
+static constexpr ParallaxStrip<64> SKY_HILLS = ridge_strip<64>(0x3A27, 8, 24, 36);
+static const ParallaxLayer SKY_LAYERS[] = {
+    PARALLAX_LAYER(SKY_STARS, 32, -16),
+    PARALLAX_LAYER(SKY_RIDGES, 64, -32),
+    PARALLAX_LAYER(SKY_HILLS, 128, -64),
+};
+static Parallax sky;
+
+// Global variables for map exploration. playerX/Y are the player's tile.
+int playerX = MAP_START_X;
+int playerY = MAP_START_Y;
 int viewportX = 0;
 int viewportY = 0;
 
-static void drawPixel(N5110 &lcd, int x, int y, FillType color) {
-    lcd.drawRect(x, y, 1, 1, color);
-}
-
-void drawBitmap(N5110 &lcd, int x, int y, const unsigned char *bitmap, int width, int height) {
-    int bytesPerRow = (width + 7) / 8;
-    for (int row = 0; row < height; row++) {
-        for (int col = 0; col < width; col++) {
-            int byteIndex = row * bytesPerRow + (col / 8);
-            int bitIndex = 7 - (col % 8);
-            if (bitmap[byteIndex] & (1 << bitIndex)) {
-                drawPixel(lcd, x + col, y + row, FILL_BLACK);
-            }
-        }
-    }
-}
-
-bool isSolid(int tile) {
-    switch (tile) {
-        case TILE_WALL:
-        case TILE_HAB:
-        case TILE_ROVER:
-        case TILE_TERMINAL:
-        case TILE_CRATER:
-            return true;
-        default:
-            return false;
-    }
-}
-
 void updateViewport() {
     viewportX = playerX - VIEWPORT_WIDTH / 2;
     viewportY = playerY - VIEWPORT_HEIGHT / 2;
     if (viewportX < 0) viewportX = 0;
     if (viewportY < 0) viewportY = 0;
-    if (viewportX > MAP_WIDTH - VIEWPORT_WIDTH) viewportX = MAP_WIDTH - VIEWPORT_WIDTH;
+    if (viewportX > world->width() - VIEWPORT_WIDTH) viewportX = world->width() - VIEWPORT_WIDTH;
     if (viewportY > MAP_HEIGHT - VIEWPORT_HEIGHT) viewportY = MAP_HEIGHT - VIEWPORT_HEIGHT;
 }
 
-void exploreMap(N5110 &lcd, Joystick &joystick, DigitalIn &selectButton) {
-    for (int x = 0; x < MAP_WIDTH; x++) {
-        map[0][x] = TILE_WALL;
-        map[MAP_HEIGHT - 1][x] = TILE_WALL;
-    }
-    for (int y = 0; y < MAP_HEIGHT; y++) {
-        map[y][0] = TILE_WALL;
-        map[y][MAP_WIDTH - 1] = TILE_WALL;
+// Player physics, reset each time the mode starts; the tuning is in games.h
+static const int PLAYER_WIDTH = 6;
+static const int PLAYER_HEIGHT = TILE_SIZE;
+static PlatformBody player(PLAYER_WIDTH, PLAYER_HEIGHT);
+static MoveAxis walk;  // analog walking speed, capped at a tile per frame
+
+static void resetPhysics() {
+    // centred in the start tile, standing on its floor
+    player.place(playerX * TILE_SIZE + (TILE_SIZE - PLAYER_WIDTH) / 2,
+                 (playerY + 1) * TILE_SIZE - PLAYER_HEIGHT);
+    walk.reset();
+}
+
+// Rovers that fell out of the window park again on the tile they woke from,
+// out of sight, which puts the world back as its source has it and so frees
+// the overlay entry the wake took. One whose home is still in the window
+// waits, stopped, until the window leaves that too. Parked rovers inside the
+// window wake up while there is room for them.
+static bool inWindow(int x, int left) { return x >= left && x < left + ROVER_COLUMNS; }
+
+static void parkRovers(int left) {
+    for (int i = 0; i < roverCount; i++) {
+        Rover &r = rovers[i];
+        if (inWindow(r.x, left) || inWindow(r.homeX, left)) continue;
+        if (world->set(r.homeX, r.homeY, TILE_ROVER)) rovers[i--] = rovers[--roverCount];
     }
+}
 
-    for (int y = 5; y <= 6; y++) {
-        for (int x = 7; x <= 9; x++) {
-            map[y][x] = TILE_HAB;
+static void wakeRovers(int left) {
+    for (int x = left; x < left + ROVER_COLUMNS && roverCount < MBED_CONF_APP_EXPLORE_ROVERS; x++) {
+        for (int y = 0; y < MAP_HEIGHT && roverCount < MBED_CONF_APP_EXPLORE_ROVERS; y++) {
+            if (world->get(x, y) != TILE_ROVER || !world->set(x, y, TILE_EMPTY)) continue;
+            Rover &r = rovers[roverCount++];
+            r.x = r.homeX = x;
+            r.y = r.homeY = y;
+            r.dir = 0;
+            r.travelled = 0;
         }
     }
+}
 
-    for (int x = 7; x <= 9; x++) {
-    map[8][x] = TILE_WALL; // assuming MAP_HEIGHT > 8
+// Move the window when the player nears its edge, and point chase at the player
+static void steerRovers() {
+    int left = playerX - ROVER_COLUMNS / 2;
+    left = left < 0 ? 0 : left - left % ROVER_WINDOW_STEP;
+
+    if (left != windowLeft) {
+        windowLeft = left;
+        parkRovers(left);
+        wakeRovers(left);
+        chase.begin(*world, left);
+        home.begin(*world, left);
+        for (int x = left; x < left + ROVER_COLUMNS; x++) {
+            for (int y = 0; y < MAP_HEIGHT; y++) {
+                // beside the bottom row of each habitat
+                if (world->get(x, y) != TILE_HAB || world->get(x, y + 1) == TILE_HAB) continue;
+                if (world->get(x - 1, y) != TILE_HAB) home.goal(x - 1, y);
+                if (world->get(x + 1, y) != TILE_HAB) home.goal(x + 1, y);
+            }
+        }
+        home.build();
+        for (int i = 0; i < roverCount; i++) {
+            int row = chase.land(rovers[i].x, rovers[i].y);  // woken off a stack of rovers
+            if (rovers[i].dir == 0 && row >= 0) rovers[i].y = row;
+        }
+        chaseX = -1;
     }
+    if (playerX != chaseX || playerY != chaseY) {
+        chaseX = playerX;
+        chaseY = playerY;
+        chase.clear();
+        chase.goal(playerX, playerY);
+        chase.build();
+    }
+}
 
-    for (int x = 15; x < 20; x++) map[6][x] = TILE_ROVER;
-
-
-    map[5][26] = TILE_CRATER;
-    map[5][27] = TILE_CRATER;
-    map[5][28] = TILE_CRATER;
-    map[6][25] = TILE_CRATER;
-    map[6][29] = TILE_CRATER;
-    for (int x = 25; x <= 29; x++) map[6][x] = TILE_CRATER;
+// A flow field lookup when a rover reaches a tile, then a pixel a frame
+static void driveRovers() {
+    for (int i = 0; i < roverCount; i++) {
+        Rover &r = rovers[i];
+        if (r.dir == 0) {
+            FlowField &field = chase.reachable(r.x, r.y) ? chase : home;
+            int dir = field.direction(r.x, r.y);
+            int row = field.next_row(r.x, r.y, dir);
+            if (dir == 0 || row < 0) continue;
+            r.dir = dir;
+            r.nextY = row;
+            r.travelled = 0;
+        }
+        r.travelled += ROVER_SPEED;
+        if (r.travelled >= TILE_SIZE) {
+            r.x += r.dir;
+            r.y = r.nextY;
+            r.dir = 0;
+        }
+    }
+}
 
-    for (int x = 35; x < 38; x++) map[6][x] = TILE_TERMINAL;
+// One simulation tick of the player.
+static void updateExplore(InputFrame const &in) {
+    bool jump_held = in.buttons & BUTTON_JOY;
+    int dx = DIRECTION_DX[in.d];
+    fixed_t speed = walk.speed(dx, in.mag, MOVE_ROW_WALK) * TILE_SIZE;  // Q8 tiles to Q8 pixels
+
+    if (dx != 0) heading = dx;
+    player.step(*world, speed, jump_held, EXPLORE_TUNING);
+    playerX = player.tile_x();
+    playerY = player.tile_y();
+
+    updateViewport();
+    world->focus(viewportX, VIEWPORT_WIDTH, heading);
+#if MBED_CONF_APP_EXPLORE_DARK
+    sight.update(*world, playerX, playerY);
+#endif
+#if MBED_CONF_APP_EXPLORE_ROVERS
+    steerRovers();
+    driveRovers();
+#endif
+    LOG_TRACE(LOG_EXPLORE_PLAYER, playerX, playerY, world->get(playerX, playerY));
+}
 
-    lcd.clear();
-    lcd.printString("Explore Mars", 0, 1);
-    lcd.printString("Use joystick", 0, 2);
-    lcd.printString("to move", 0, 3);
-    lcd.printString("Press select", 0, 4);
-    lcd.refresh();
+static void drawExplore(N5110 &lcd, bool background) {
+    if (background) {
+        sky.scroll(viewportX * TILE_SIZE, viewportY * TILE_SIZE);
+        sky.draw(lcd, 0, WIDTH);  // every pixel, so no clear
+    } else {
+        lcd.clear();
+    }
+    for (int row = 0; row < VIEWPORT_HEIGHT; row++) {
+        for (int col = 0; col < VIEWPORT_WIDTH; col++) {
+            int x = viewportX + col, y = viewportY + row;
+            Shade s = shade(x, y);
+            if (s == SHADE_HIDDEN) {
+                // unexplored is blank, as it is without the sky, not open sky
+                lcd.blitBank(col * TILE_SIZE, TILE_FIRST_BANK + row, UNSEEN, TILE_SIZE);
+                continue;
+            }
+            int tile = world->get(x, y);
+            if (tile == TILE_EMPTY) continue;  // the sky shows through
+            int image = tileAnims.image(tile, x, y);
+            if (s == SHADE_VISIBLE) {
+                drawTile(lcd, image, col, row);
+            } else {
+                drawTileDimmed(lcd, image, col, row);
+            }
+        }
+    }
 
-    while (selectButton.read() == 1) ThisThread::sleep_for(100ms);
-    while (selectButton.read() == 0) ThisThread::sleep_for(50ms);
+    // each habitat's picture sits on its bottom-left hab tile, which may be just off screen
+    for (int row = 0; row < VIEWPORT_HEIGHT + HAB_ROWS - 1; row++) {
+        for (int col = 1 - HAB_COLUMNS; col < VIEWPORT_WIDTH; col++) {
+            int x = viewportX + col, y = viewportY + row;
+            if (shade(x, y) != SHADE_HIDDEN && world->get(x, y) == TILE_HAB && world->get(x - 1, y) != TILE_HAB &&
+                world->get(x, y + 1) != TILE_HAB) {
+                drawHabitat(lcd, col, row - (HAB_ROWS - 1), VIEWPORT_HEIGHT);
+            }
+        }
+    }
 
-    float y_velocity = 0.0f;
-    bool jumping = false;
-    int jump_timer = 0;
-    bool on_ground = false;
-    int coyote_timer = 0;
-    const int MAX_JUMP_FRAMES = 10;
-    const int COYOTE_FRAMES = 6;
-    const float GRAVITY = 0.25f;
-    const float JUMP_FORCE = -0.8f;
-    const float MAX_FALL_SPEED = 2.0f;
+    for (int i = 0; i < roverCount; i++) {
+        Rover const &r = rovers[i];
+        int row = r.y - viewportY;
+        if (row < 0 || row >= VIEWPORT_HEIGHT || shade(r.x, r.y) != SHADE_VISIBLE) continue;
+        lcd.blitBank((r.x - viewportX) * TILE_SIZE + r.dir * r.travelled, TILE_FIRST_BANK + row,
+                     TILE_ATLAS[TILE_ROVER], TILE_SIZE);
+    }
 
-    while (true) {
-        
+    int px = player.x() - viewportX * TILE_SIZE;
+    int py = player.y() - viewportY * TILE_SIZE + TILE_FIRST_BANK * 8;
+    lcd.drawRect(px, py, PLAYER_WIDTH, PLAYER_HEIGHT, FILL_BLACK);
+}
 
-        lcd.clear();
+// --- Scripts ---
+static bool playing = false;  // false while the splash screen is up
 
-        Direction d = joystick.get_direction();
-        int newX = playerX;
-        if (d == E) newX++; 
-        else if (d == W) newX--;
+static bool welcomeScript(Script &s, ScriptContext &ctx) {
+    SCRIPT_BEGIN(s);
+    SCRIPT_SAY(s, ctx, "Explore Mars\nUse joystick\nto move\nPress select");
+    SCRIPT_WAIT_PRESS(s, ctx, BUTTON_SELECT);
+    ctx.close();
+    playing = true;
+    SCRIPT_END(s);
+}
 
-        on_ground = (playerY + 1 < MAP_HEIGHT && isSolid(map[playerY + 1][playerX]) );
+static const char *const TERMINAL_TEXT[] = {
+    "TERMINAL 1\nO2 plant   OK\nWater      OK",
+    "TERMINAL 2\nComms    DOWN\nDish misaligned",
+    "TERMINAL 3\nRover bay\n5 rovers parked",
+};
+
+// arg is the terminal's column
+static bool terminalScript(Script &s, ScriptContext &ctx) {
+    SCRIPT_BEGIN(s);
+    SCRIPT_SAY(s, ctx, TERMINAL_TEXT[((s.arg - TERMINAL_FIRST_X) % 3 + 3) % 3]);
+    SCRIPT_WAIT_PRESS(s, ctx, BUTTON_SELECT);
+    ctx.close();
+    SCRIPT_END(s);
+}
 
-        if (on_ground) {
-            coyote_timer = COYOTE_FRAMES;
-        } else if (coyote_timer > 0) {
-            coyote_timer--;
-        }
+static bool habScript(Script &s, ScriptContext &ctx) {
+    SCRIPT_BEGIN(s);
+    SCRIPT_SAY(s, ctx, "HABITAT\nCycling airlock");
+    SCRIPT_WAIT_FRAMES(s, 10);
+    SCRIPT_SAY(s, ctx, "HABITAT\nSuit recharged\nselect: leave");
+    SCRIPT_WAIT_PRESS(s, ctx, BUTTON_SELECT);
+    ctx.close();
+    SCRIPT_END(s);
+}
 
-        if (!jumping && coyote_timer > 0 && joystick.button_pressed()) {
-            jumping = true;
-            jump_timer = MAX_JUMP_FRAMES;
-            y_velocity = JUMP_FORCE;
-        }
+// Column of a tile of this type under or beside the player, -1 if none
+static int tileNear(int type) {
+    if (world->get(playerX, playerY + 1) == type) return playerX;
+    if (world->get(playerX - 1, playerY) == type) return playerX - 1;
+    if (world->get(playerX + 1, playerY) == type) return playerX + 1;
+    return -1;
+}
 
-        if (jumping) {
-            if (jump_timer > 0 && joystick.button_pressed()) {
-                y_velocity = JUMP_FORCE;
-                jump_timer--;
-            } else {
-                jumping = false;
-            }
-        }
+ExploreScene::ExploreScene(InputSource &input, MapStore &maps)
+    : Scene("Explore"), input(input), maps(maps), loaded(false) { }
 
-        if (!joystick.button_pressed()) {
-            jumping = false;
-            jump_timer = 0;
-        }
+void ExploreScene::preload() {
+    if (loaded) return;
 
-        if (!on_ground || y_velocity < 0.0f) {
-            y_velocity += GRAVITY;
-            if (y_velocity > MAX_FALL_SPEED) y_velocity = MAX_FALL_SPEED;
-        }
+#if MBED_CONF_APP_EXPLORE_WORLD == 0
+    // the world is linked in, so a bad header is a build problem
+    if (!marsSource.open()) error("Explore: Mars world is corrupt\n");
+#endif
+    loaded = true;
+}
 
-        float newYf = (float)playerY + y_velocity;
-        int newY = (int)(newYf + 0.5f);
-        if (newY < 0) newY = 0;
-        if (newY >= MAP_HEIGHT) {
-            newY = MAP_HEIGHT - 1;
-            y_velocity = 0;
-            jumping = false;
-        }
+void ExploreScene::enter() {
+    // start from the same place every time so recorded sessions replay exactly
+    playerX = MAP_START_X;
+    playerY = MAP_START_Y;
+    resetPhysics();
+    heading = 1;
+#if MBED_CONF_APP_EXPLORE_WORLD == 3
+    // read from flash on every visit, so a map saved in the editor is played straight away
+    TileMap *slot = arena().array<TileMap>(1);
+    if (maps.load(MBED_CONF_APP_MAP_SLOT, *slot)) {
+        saved.attach(slot);
+        world = &saved;
+    } else {
+        landing.init(arena(), MBED_CONF_APP_WORLD_EDITS);
+        world = &landing;
+    }
+#elif MBED_CONF_APP_EXPLORE_WORLD == 2
+    landing.init(arena(), MBED_CONF_APP_WORLD_EDITS);
+    world = &landing;
+#elif MBED_CONF_APP_EXPLORE_WORLD == 1
+    chunks.init(arena(), MBED_CONF_APP_CHUNK_CACHE_SLOTS, terrain, MBED_CONF_APP_WORLD_EDITS);
+    world = &chunks;
+#else
+    chunks.init(arena(), MBED_CONF_APP_CHUNK_CACHE_SLOTS, marsSource, MBED_CONF_APP_WORLD_EDITS);
+    world = &chunks;
+#endif
+    updateViewport();
+    world->focus(viewportX, VIEWPORT_WIDTH, heading);
+#if MBED_CONF_APP_EXPLORE_DARK
+    sight.init(arena(), SIGHT_RADIUS, EXPLORED_COLUMNS);
+    sight.update(*world, playerX, playerY);
+#endif
+    tileAnims.init(arena());
+    sky.init(SKY_LAYERS, 3);
+    roverCount = 0;
+#if MBED_CONF_APP_EXPLORE_ROVERS
+    rovers = arena().array<Rover>(MBED_CONF_APP_EXPLORE_ROVERS);
+    chase.init(arena(), ROVER_COLUMNS, ROVER_CLIMB);
+    home.init(arena(), ROVER_COLUMNS, ROVER_CLIMB);
+    windowLeft = -1;
+    steerRovers();
+#endif
+    input.begin_session();
+
+    playing = false;
+    scripts.init(arena(), 2);
+    scripts.start(welcomeScript);
+}
 
-        if (!isSolid(map[playerY][newX])) {
-            playerX = newX;
-        }
+void ExploreScene::update(InputFrame const &in, uint8_t pressed) {
+    tileAnims.tick();  // the scene draws every frame, so what changed doesn't matter
 
-        if (!isSolid(map[newY][playerX])) {
-            playerY = newY;
-        } else {
-            y_velocity = 0;
-            jumping = false;
-        }
+    // the splash screen and text boxes hold the game, including the tick that closes them
+    bool held = !playing || ctx.showing();
+    ctx.set_input(in, pressed);
+    scripts.run(ctx);
+    if (held) return;
 
-        updateViewport();
-
-        const unsigned char hab[] = {
-            0xf0, 0x6f, 0xff, 0xff, 0x57, 0xff, 0xff, 0x3b, 0xff, 0xff, 0x7d, 0xff, 0xfe, 0xfe, 0xff, 0xfd,
-            0xff, 0x7f, 0xfb, 0xff, 0xbf, 0xf7, 0xff, 0xdf, 0xef, 0xff, 0xef, 0xdf, 0xff, 0xf7, 0xbf, 0xff,
-            0xfb, 0x00, 0x00, 0x01, 0xdf, 0xff, 0xff, 0xdf, 0xf0, 0x1f, 0xd0, 0x37, 0xdf, 0xd6, 0xb7, 0xdf,
-            0xd6, 0xb7, 0xdf, 0xd6, 0xb7, 0xdf, 0xd6, 0xb7, 0xdf, 0xd0, 0x37, 0xdf, 0xdf, 0xf7, 0xdf, 0xdf,
-            0xf7, 0xdf, 0xdf, 0xf7, 0xdf, 0xc0, 0x00, 0x07
-        };
-
-        for (int row = 0; row < VIEWPORT_HEIGHT; row++) {
-            for (int col = 0; col < VIEWPORT_WIDTH; col++) {
-                int mapX = viewportX + col;
-                int mapY = viewportY + row;
-                int tile = map[mapY][mapX];
-                int x_pixel = col * TILE_SIZE;
-                int y_pixel = row * TILE_SIZE + 8;
-
-                if (tile == TILE_HAB && mapY == 6 && mapX >= 5 && mapX < 10) {
-                    if (mapX == 7) {
-                        int habBitmapX = (mapX - viewportX) * TILE_SIZE;
-                        int habBitmapY = (mapY - viewportY) * TILE_SIZE + 8 + TILE_SIZE - 24;
-                        drawBitmap(lcd, habBitmapX, habBitmapY, hab, 24, 24);
-                    }
-                } else {
-                    switch (tile) {
-                        case TILE_WALL:
-                            lcd.drawRect(x_pixel, y_pixel, TILE_SIZE, TILE_SIZE, FILL_BLACK);
-                            break;
-                        case TILE_ROVER:
-                            lcd.drawLine(x_pixel, y_pixel + 4, x_pixel + 7, y_pixel + 4, FILL_BLACK);
-                            break;
-                        case TILE_CRATER: {
-                            for (int dx = 0; dx < TILE_SIZE; dx++) {
-                                for (int dy = 0; dy < TILE_SIZE; dy++) {
-                                    if ((dy == 0 && (dx > 2 && dx < 5)) ||
-                                        (dy == 1 && (dx == 2 || dx == 5)) ||
-                                        (dy == 2 && (dx == 1 || dx == 6)) ||
-                                        (dy == 3 && dx >= 2 && dx <= 5)) {
-                                        lcd.setPixel(x_pixel + dx, y_pixel + dy);
-                                    }
-                                }
-                            }
-                            break;
-                        }
-                        case TILE_TERMINAL:
-                            lcd.drawLine(x_pixel + 1, y_pixel + 1, x_pixel + 6, y_pixel + 6, FILL_BLACK);
-                            lcd.drawLine(x_pixel + 6, y_pixel + 1, x_pixel + 1, y_pixel + 6, FILL_BLACK);
-                            break;
-                        default:
-                            break;
-                    }
-                }
-            }
+    if (pressed & BUTTON_SELECT) {
+        change(SCENE_MENU);
+        return;
+    }
+    updateExplore(in);
+
+    // pull down on the stick at a terminal or the habitat to use it
+    if (in.d == S && scripts.live() == 0) {
+        int x = tileNear(TILE_TERMINAL);
+        if (x >= 0) {
+            scripts.start(terminalScript, x);
+        } else if (tileNear(TILE_HAB) >= 0) {
+            scripts.start(habScript);
         }
+    }
+}
 
-        int px = (playerX - viewportX) * TILE_SIZE + 1;
-        int py = (playerY - viewportY) * TILE_SIZE + 1 + 8 - playerYOffset;
-        printf("Player at (%d,%d), Tile = %d\n", playerX, playerY, map[playerY][playerX]);
-        lcd.drawRect(px, py, TILE_SIZE, TILE_SIZE, FILL_BLACK);
-        
-        lcd.refresh();
+// What a replay has to reproduce: the player, the world's changes and the rovers
+uint32_t ExploreScene::state() const {
+    uint32_t hash = state_mix(playing, player.x());
+    hash = state_mix(hash, player.y());
+    hash = state_mix(hash, player.speed_y());
+    hash = state_mix(hash, world->revision());
+    for (int i = 0; i < roverCount; i++) {
+        hash = state_mix(hash, rovers[i].x);
+        hash = state_mix(hash, rovers[i].y << 8 | rovers[i].travelled);
+    }
+    return hash;
+}
 
-        if (selectButton.read() == 0) {
-            while (selectButton.read() == 0) ThisThread::sleep_for(50ms);
-            break;
-        }
-        ThisThread::sleep_for(100ms);
+void ExploreScene::draw(N5110 &lcd) {
+    if (playing) {
+        drawExplore(lcd, quality(QUALITY_BACKGROUND));
+        ctx.draw(lcd, 2);
+    } else {
+        lcd.clear();
+        ctx.draw(lcd, 1);
     }
 }
+
+void ExploreScene::exit() {
+    input.end_session();
+    world->report();
+}
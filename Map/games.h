@@ -3,29 +3,100 @@
 
 #include "mbed.h"
 #include "N5110.h"
-#include "Joystick.h"
+#include "InputSource.h"
+#include "Scene.h"
+#include "Script.h"
+#include "TileMap.h"
+#include "ChunkCache.h"
+#include "TerrainGenerator.h"
+#include "FlashLevel.h"
+#include "PlatformBody.h"
+#include "FieldOfView.h"
+#include "Raycast.h"
+#include "FlowField.h"
+#include "TileAnimator.h"
+#include "Parallax.h"
+#include "MapStore.h"
 
-// World size definitions
-#define MAP_WIDTH 60
-#define MAP_HEIGHT 8
-
-// Tile size and viewport
-#define TILE_SIZE 8
+// Viewport in tiles
 #define VIEWPORT_WIDTH 10
 #define VIEWPORT_HEIGHT 4
 
-// Tile types
+// Terminal text cycles every three columns, starting from this one
+#define TERMINAL_FIRST_X 35
+
+// The explorer's jump: the old tile-per-frame feel (gravity 0.25, jump 0.8,
+// max fall 2) in Q8 pixels. The map editor marks floor the player can't get
+// to by the walls this clears, so the two can't disagree.
+static constexpr PlatformTuning EXPLORE_TUNING = {
+    2 * FIXED_ONE,          // gravity
+    -1638,                  // jump speed, -6.4 pixels per frame
+    16 * FIXED_ONE,         // max fall
+    10,                     // jump frames
+    6,                      // coyote frames
+};
+static constexpr int EXPLORE_CLIMB = jump_height(EXPLORE_TUNING) / (TILE_SIZE << FIXED_SHIFT);  // 47 pixels: 5 tiles
+
+#ifndef MBED_CONF_APP_EXPLORE_WORLD
+#define MBED_CONF_APP_EXPLORE_WORLD 1
+#endif
+#ifndef MBED_CONF_APP_EXPLORE_DARK
+#define MBED_CONF_APP_EXPLORE_DARK 0
+#endif
+#ifndef MBED_CONF_APP_EXPLORE_ROVERS
+#define MBED_CONF_APP_EXPLORE_ROVERS 4
+#endif
+#ifndef MBED_CONF_APP_MAP_SLOT
+#define MBED_CONF_APP_MAP_SLOT 0
+#endif
+#ifndef MBED_CONF_APP_WORLD_SEED
+#define MBED_CONF_APP_WORLD_SEED 2026
+#endif
+
+// The explorer's world file, generated from mars.txt by tools/worldpack.py
+extern const uint8_t MARS_WORLD[];
+extern const size_t MARS_WORLD_SIZE;
+
+// The landing site, packed from level art at compile time (levels.cpp)
+extern const PackedLevel<MAP_WIDTH> LANDING_LEVEL;
+
+
+// The two game modes. Each opens on a splash screen and records or replays
+// its input as one InputSource session.
+class ExploreScene : public Scene {
+public:
+    ExploreScene(InputSource &input, MapStore &maps);
+
+    void preload() override;  // opens the world
+    void enter() override;
+    void update(InputFrame const &in, uint8_t pressed) override;
+    void draw(N5110 &lcd) override;
+    void exit() override;
+    uint32_t state() const override;  // for checking a replay
+
+private:
+    InputSource &input;
+    MapStore &maps;  // for a map saved from the editor
+    bool loaded;
+    ScriptRunner scripts;  // splash screen and tile interactions
+    ScriptContext ctx;
+};
 
-#define TILE_EMPTY    0  // No tile
-#define TILE_WALL     1  // Solid line at bottom
-#define TILE_HAB      2  // Small black rectangle (Habitat module)
-#define TILE_ROVER    3  // Filled square (Rover)
-#define TILE_CRATER   4  // Line in the middle (Crater)
-#define TILE_TERMINAL 5  // Two pixels (Terminal)
+class InvadersScene : public Scene {
+public:
+    InvadersScene(InputSource &input);
 
+    void enter() override;
+    void update(InputFrame const &in, uint8_t pressed) override;
+    void draw(N5110 &lcd) override;
+    void exit() override;
+    uint32_t state() const override;  // for checking a replay
+    Kernel::Clock::duration tick() const override;  // speeds up with the level
 
-// Function declarations for the two game modes:
-void exploreMap(N5110 &lcd, Joystick &joystick, DigitalIn &selectButton);
-void spaceInvadeGame(N5110 &lcd, Joystick &joystick, DigitalIn &selectButton);
+private:
+    InputSource &input;
+    ScriptRunner scripts;  // splash screen, level-up show and game over
+    ScriptContext ctx;
+};
 
 #endif
@@ -0,0 +1,17 @@
+#include "games.h"
+
+// The landing site: the original hand-built explorer level, packed into flash
+// by the compiler. tools/mapconv.py turns a map editor export into art to paste here.
+constexpr char LANDING_ART[MAP_HEIGHT][MAP_WIDTH + 1] = {
+    "############################################################",
+    "#..........................................................#",
+    "#..........................................................#",
+    "#..........................................................#",
+    "#..........................................................#",
+    "#......HHH................OOO..............................#",
+    "#......HHH.....RRRRR.....OOOOO.....TTT.....................#",
+    "############################################################",
+};
+
+constexpr PackedLevel<MAP_WIDTH> LANDING_LEVEL = pack_level<MAP_WIDTH>(LANDING_ART);
+static_assert(LANDING_LEVEL.valid, "landing site art has a short row or an unknown tile");
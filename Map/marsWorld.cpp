@@ -0,0 +1,132 @@
+// Generated by tools/worldpack.py from mars.txt - edit that and regenerate
+// 2048 columns in 128 chunks, 1966 bytes
+
+#include "mbed.h"
+
+extern const uint8_t MARS_WORLD[] = {
+    0x4d, 0x58, 0x57, 0x31, 0x80, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x1f, 0x02, 0x00, 0x00,
+    0x2c, 0x02, 0x00, 0x00, 0x36, 0x02, 0x00, 0x00, 0x42, 0x02, 0x00, 0x00, 0x4c, 0x02, 0x00, 0x00,
+    0x5a, 0x02, 0x00, 0x00, 0x68, 0x02, 0x00, 0x00, 0x76, 0x02, 0x00, 0x00, 0x80, 0x02, 0x00, 0x00,
+    0x8a, 0x02, 0x00, 0x00, 0x94, 0x02, 0x00, 0x00, 0x9d, 0x02, 0x00, 0x00, 0xa9, 0x02, 0x00, 0x00,
+    0xb5, 0x02, 0x00, 0x00, 0xc0, 0x02, 0x00, 0x00, 0xca, 0x02, 0x00, 0x00, 0xd5, 0x02, 0x00, 0x00,
+    0xe0, 0x02, 0x00, 0x00, 0xea, 0x02, 0x00, 0x00, 0xf8, 0x02, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00,
+    0x0e, 0x03, 0x00, 0x00, 0x18, 0x03, 0x00, 0x00, 0x25, 0x03, 0x00, 0x00, 0x31, 0x03, 0x00, 0x00,
+    0x3c, 0x03, 0x00, 0x00, 0x46, 0x03, 0x00, 0x00, 0x51, 0x03, 0x00, 0x00, 0x5d, 0x03, 0x00, 0x00,
+    0x6a, 0x03, 0x00, 0x00, 0x75, 0x03, 0x00, 0x00, 0x7f, 0x03, 0x00, 0x00, 0x8c, 0x03, 0x00, 0x00,
+    0x98, 0x03, 0x00, 0x00, 0xa5, 0x03, 0x00, 0x00, 0xb3, 0x03, 0x00, 0x00, 0xbf, 0x03, 0x00, 0x00,
+    0xcb, 0x03, 0x00, 0x00, 0xd6, 0x03, 0x00, 0x00, 0xe0, 0x03, 0x00, 0x00, 0xea, 0x03, 0x00, 0x00,
+    0xf4, 0x03, 0x00, 0x00, 0x01, 0x04, 0x00, 0x00, 0x0a, 0x04, 0x00, 0x00, 0x14, 0x04, 0x00, 0x00,
+    0x20, 0x04, 0x00, 0x00, 0x2b, 0x04, 0x00, 0x00, 0x35, 0x04, 0x00, 0x00, 0x40, 0x04, 0x00, 0x00,
+    0x4c, 0x04, 0x00, 0x00, 0x57, 0x04, 0x00, 0x00, 0x63, 0x04, 0x00, 0x00, 0x6d, 0x04, 0x00, 0x00,
+    0x78, 0x04, 0x00, 0x00, 0x83, 0x04, 0x00, 0x00, 0x8d, 0x04, 0x00, 0x00, 0x9b, 0x04, 0x00, 0x00,
+    0xa5, 0x04, 0x00, 0x00, 0xb0, 0x04, 0x00, 0x00, 0xba, 0x04, 0x00, 0x00, 0xc5, 0x04, 0x00, 0x00,
+    0xd0, 0x04, 0x00, 0x00, 0xdd, 0x04, 0x00, 0x00, 0xe7, 0x04, 0x00, 0x00, 0xf1, 0x04, 0x00, 0x00,
+    0xfe, 0x04, 0x00, 0x00, 0x09, 0x05, 0x00, 0x00, 0x15, 0x05, 0x00, 0x00, 0x20, 0x05, 0x00, 0x00,
+    0x2a, 0x05, 0x00, 0x00, 0x39, 0x05, 0x00, 0x00, 0x44, 0x05, 0x00, 0x00, 0x4f, 0x05, 0x00, 0x00,
+    0x5b, 0x05, 0x00, 0x00, 0x66, 0x05, 0x00, 0x00, 0x71, 0x05, 0x00, 0x00, 0x7b, 0x05, 0x00, 0x00,
+    0x86, 0x05, 0x00, 0x00, 0x91, 0x05, 0x00, 0x00, 0x9b, 0x05, 0x00, 0x00, 0xa8, 0x05, 0x00, 0x00,
+    0xb3, 0x05, 0x00, 0x00, 0xc0, 0x05, 0x00, 0x00, 0xca, 0x05, 0x00, 0x00, 0xd4, 0x05, 0x00, 0x00,
+    0xde, 0x05, 0x00, 0x00, 0xea, 0x05, 0x00, 0x00, 0xf5, 0x05, 0x00, 0x00, 0x01, 0x06, 0x00, 0x00,
+    0x0c, 0x06, 0x00, 0x00, 0x16, 0x06, 0x00, 0x00, 0x21, 0x06, 0x00, 0x00, 0x2a, 0x06, 0x00, 0x00,
+    0x36, 0x06, 0x00, 0x00, 0x41, 0x06, 0x00, 0x00, 0x4c, 0x06, 0x00, 0x00, 0x57, 0x06, 0x00, 0x00,
+    0x62, 0x06, 0x00, 0x00, 0x6c, 0x06, 0x00, 0x00, 0x76, 0x06, 0x00, 0x00, 0x81, 0x06, 0x00, 0x00,
+    0x8c, 0x06, 0x00, 0x00, 0x98, 0x06, 0x00, 0x00, 0xa3, 0x06, 0x00, 0x00, 0xae, 0x06, 0x00, 0x00,
+    0xb9, 0x06, 0x00, 0x00, 0xc4, 0x06, 0x00, 0x00, 0xce, 0x06, 0x00, 0x00, 0xd8, 0x06, 0x00, 0x00,
+    0xe1, 0x06, 0x00, 0x00, 0xeb, 0x06, 0x00, 0x00, 0xf7, 0x06, 0x00, 0x00, 0x02, 0x07, 0x00, 0x00,
+    0x0c, 0x07, 0x00, 0x00, 0x19, 0x07, 0x00, 0x00, 0x23, 0x07, 0x00, 0x00, 0x32, 0x07, 0x00, 0x00,
+    0x3c, 0x07, 0x00, 0x00, 0x48, 0x07, 0x00, 0x00, 0x55, 0x07, 0x00, 0x00, 0x5f, 0x07, 0x00, 0x00,
+    0x6a, 0x07, 0x00, 0x00, 0x75, 0x07, 0x00, 0x00, 0x81, 0x07, 0x00, 0x00, 0x89, 0x07, 0x00, 0x00,
+    0x96, 0x07, 0x00, 0x00, 0xa0, 0x07, 0x00, 0x00, 0xae, 0x07, 0x00, 0x00, 0xf1, 0x01, 0xe0, 0x01,
+    0xe0, 0x01, 0xe0, 0x01, 0xe0, 0x01, 0x50, 0x22, 0x50, 0x01, 0x50, 0x22, 0x40, 0x03, 0xf1, 0xf1,
+    0xf0, 0xf0, 0xf0, 0xf0, 0x90, 0x24, 0x20, 0x33, 0x40, 0x44, 0x10, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0x20, 0x25, 0x90, 0xf1, 0xf1, 0xf0, 0xf0, 0xb0, 0x21, 0xf0, 0x10, 0x14, 0xc0, 0x34,
+    0xb0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x60, 0x51, 0xf0, 0xf0, 0x20, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0x70, 0x04, 0x50, 0x04, 0x60, 0x24, 0x30, 0x14, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x70,
+    0x14, 0x50, 0x04, 0x50, 0x34, 0x30, 0x04, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x24, 0x60, 0x01,
+    0x40, 0x34, 0x50, 0x01, 0x40, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x10, 0x25, 0xa0, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x40, 0x13, 0x80, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x30, 0x41,
+    0xf0, 0xf0, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0x41, 0xf0, 0xf0, 0xf0, 0xa0, 0xf1, 0xf1, 0xf0, 0xf0,
+    0xf0, 0xf0, 0x50, 0x14, 0xc0, 0x34, 0x30, 0x23, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xc0, 0x14,
+    0x00, 0x13, 0x90, 0x34, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x80, 0x14, 0xc0, 0x34, 0x30, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x30, 0x25, 0x80, 0xf1, 0xf1, 0xf0, 0xf0, 0xd0, 0x11, 0xf0,
+    0xf0, 0x00, 0x43, 0x90, 0xf1, 0xf1, 0xf0, 0xf0, 0x01, 0x90, 0x21, 0xf0, 0xf0, 0xf0, 0x10, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x60, 0x43, 0x30, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x10,
+    0x04, 0xb0, 0x04, 0x00, 0x24, 0x90, 0x14, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x14, 0xa0, 0x54,
+    0x80, 0x34, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x70, 0x41, 0xf0, 0x20, 0x04, 0xe0, 0xf1, 0xf1, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0x50, 0x25, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x00, 0x51, 0xf0, 0x60,
+    0x01, 0xe0, 0x01, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x40, 0x25, 0x30, 0x23, 0x00,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x80, 0x24, 0xb0, 0x44, 0x20, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0x80, 0x25, 0x30, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x50, 0x14, 0xc0, 0x34, 0x60,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x10, 0x14, 0xc0, 0x34, 0x70, 0x23, 0xf1, 0xf1, 0xf0, 0xf0,
+    0xf0, 0xf0, 0x70, 0x04, 0x60, 0x03, 0x50, 0x24, 0x50, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x00, 0x41,
+    0xf0, 0xf0, 0x40, 0x43, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x30, 0x25, 0x80, 0xf1, 0xf1,
+    0xf0, 0xf0, 0xf0, 0xf0, 0x10, 0x01, 0xe0, 0x01, 0x80, 0x23, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xc0, 0x24, 0x50, 0x13, 0x30, 0x34, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x90, 0x24, 0x20,
+    0x04, 0x70, 0x44, 0x10, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x70, 0x01, 0x50, 0x04, 0x70, 0x01,
+    0x40, 0x14, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x60, 0x41, 0x30, 0x14, 0xd0, 0x24, 0xc0, 0xf1, 0xf1,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xe0, 0x04, 0x00, 0x33, 0x80, 0x14, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xb0,
+    0x31, 0x14, 0xd0, 0x24, 0xc0, 0xf1, 0xf1, 0xf0, 0xf0, 0x70, 0x41, 0xf0, 0xf0, 0xf0, 0x20, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0x30, 0x31, 0xf0, 0xf0, 0x70, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xe0, 0x01,
+    0xf0, 0x43, 0xa0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x21, 0xf0, 0x40, 0x14, 0xc0, 0x34, 0x30, 0x03,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x23, 0xc0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+    0x50, 0x13, 0x70, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x14, 0xc0, 0x34, 0x80, 0x25, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xb0, 0x14, 0xc0, 0x34, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0x60, 0x31,
+    0xf0, 0xf0, 0xf0, 0x40, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x80, 0x01, 0xe0, 0x01, 0x50, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x30, 0x24, 0xb0, 0x44, 0x60, 0x03, 0xf1, 0xf1, 0xf0, 0xf0, 0xa0,
+    0x21, 0xf0, 0xf0, 0x10, 0x13, 0xd0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x40, 0x01, 0xe0, 0x01,
+    0x60, 0x23, 0xf1, 0xf1, 0xf0, 0xf0, 0x80, 0x31, 0xf0, 0xf0, 0xf0, 0x20, 0xf1, 0xf1, 0xf0, 0xf0,
+    0xe0, 0x01, 0x10, 0x51, 0xf0, 0xf0, 0x70, 0xf1, 0xf1, 0xf0, 0xf0, 0x41, 0xf0, 0xf0, 0xf0, 0x60,
+    0x25, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x80, 0x25, 0x30, 0xf1, 0xf1, 0xf0, 0xf0,
+    0xf0, 0xf0, 0x30, 0x14, 0x70, 0x04, 0x30, 0x34, 0x50, 0x24, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x50,
+    0x51, 0xf0, 0xf0, 0x30, 0xf1, 0xf1, 0xf0, 0xf0, 0x41, 0xf0, 0xf0, 0x90, 0x01, 0xe0, 0xf1, 0x01,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x40, 0x13, 0x80, 0xf1, 0xf1, 0xf0, 0xf0, 0x40, 0x31, 0x50,
+    0x01, 0xf0, 0xf0, 0xf0, 0xf1, 0xf1, 0xf0, 0xf0, 0x31, 0xf0, 0xf0, 0xf0, 0x30, 0x25, 0x40, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x20, 0x01, 0xe0, 0x01, 0x70, 0x25, 0x00, 0xf1, 0xf1, 0xf0, 0xf0,
+    0xf0, 0xf0, 0xf0, 0x60, 0x25, 0x50, 0xf1, 0xf1, 0xf0, 0xf0, 0x20, 0x31, 0xf0, 0xf0, 0xf0, 0x80,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x00, 0x25, 0x30, 0x23, 0x30, 0x03, 0xf1, 0xf1, 0xf0,
+    0xf0, 0xf0, 0xb0, 0x21, 0xf0, 0x00, 0x23, 0xc0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xe0, 0x01, 0x50,
+    0x14, 0xc0, 0x34, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x31, 0xf0, 0xf0, 0x30, 0x43, 0x20, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x60, 0x25, 0x50, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x60,
+    0x01, 0x80, 0x13, 0x30, 0x01, 0x30, 0x25, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x30, 0x24,
+    0xb0, 0x44, 0x70, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x60, 0x24, 0xb0, 0x44, 0x40, 0xf1, 0xf1,
+    0xf0, 0xf0, 0xf0, 0xf0, 0xe0, 0x01, 0x30, 0x43, 0x50, 0xf1, 0x01, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0,
+    0x80, 0x14, 0xc0, 0x34, 0x30, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x50, 0x24, 0xb0, 0x44, 0x50,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x41, 0xf0, 0xf0, 0x90, 0x03, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0,
+    0xd0, 0x14, 0x03, 0xb0, 0x24, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x04, 0x90, 0x33, 0x00,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x60, 0x33, 0x40, 0xf1, 0xf1, 0xf0, 0xf0, 0x21, 0xf0,
+    0xb0, 0x01, 0x80, 0x04, 0xd0, 0x24, 0x40, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x31, 0xf0, 0xf0, 0x30,
+    0x23, 0x40, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xc0, 0x01, 0x20, 0x43, 0x60, 0x01, 0x10, 0xf1,
+    0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x70, 0x23, 0x40, 0xf1, 0xf1, 0xf0, 0xf0, 0x40, 0x31, 0xf0,
+    0xf0, 0xf0, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x10, 0x51, 0xf0, 0xf0, 0x70, 0xf1, 0xf1, 0xf0,
+    0xf0, 0x10, 0x31, 0xf0, 0xf0, 0xf0, 0x30, 0x25, 0x20, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x50,
+    0x14, 0xc0, 0x34, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x40, 0x04, 0xd0, 0x24, 0x70, 0x03,
+    0xf1, 0xf1, 0xf0, 0xf0, 0x80, 0x41, 0xf0, 0xf0, 0x10, 0x23, 0xc0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0xf0, 0x60, 0x23, 0x50, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xc0, 0x21, 0xf0, 0x00, 0x23, 0xb0,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x01, 0xf0, 0xf0, 0xe0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x30,
+    0x01, 0xe0, 0x01, 0x70, 0x25, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x50, 0x01, 0xe0, 0x01, 0x80,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x40, 0x24, 0xb0, 0x44, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0x30, 0x24, 0xb0, 0x44, 0x70, 0xf1, 0xf1, 0xf0, 0xf0, 0x70, 0x51, 0xf0, 0xf0, 0x10, 0x25,
+    0xc0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x40, 0x33, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0x20,
+    0x51, 0xf0, 0xf0, 0xf0, 0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0xa0, 0x41, 0x10, 0x21, 0xf0, 0xf0, 0xa0,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x90, 0x04, 0xd0, 0x24, 0x30, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0x30, 0x01, 0xe0, 0x01, 0x90, 0x05, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x15, 0x70,
+    0x43, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0x50, 0x31, 0xf0, 0x30, 0x11, 0xf0, 0xf0, 0xf1, 0xf1, 0xf0,
+    0xf0, 0xf0, 0x31, 0xf0, 0xf0, 0x70, 0x25, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x40,
+    0x23, 0x40, 0x25, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x50, 0x41, 0xf0, 0xf0, 0x40, 0xf1, 0xf1, 0xf0,
+    0xf0, 0xf0, 0xf0, 0xf0, 0x23, 0x80, 0x33, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x03, 0xe0,
+    0xf1, 0xf1, 0xf0, 0xf0, 0x10, 0x31, 0xf0, 0xf0, 0xf0, 0x90, 0xf1, 0xf1, 0xf0, 0xf0, 0x20, 0x31,
+    0xf0, 0x30, 0x21, 0xf0, 0xf0, 0x10, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x70, 0x01, 0xe0, 0x01,
+    0x60, 0xf1, 0xf1, 0xf0, 0xf0, 0x00, 0x31, 0xf0, 0xf0, 0xf0, 0xa0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0x00, 0x24, 0xb0, 0x44, 0x30, 0x33, 0x20, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x40,
+    0x25, 0x70, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x10, 0x14, 0x80, 0x04, 0x20, 0x34, 0x60, 0x24,
+    0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x60, 0x31, 0xf0, 0xf0, 0x40, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0,
+    0xf0, 0x40, 0x24, 0xb0, 0x44, 0x50, 0x04, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0x04, 0xb0, 0x14,
+    0x00, 0x14, 0x90, 0x34, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0x90, 0x25, 0x20, 0xf1, 0xf1,
+    0xf0, 0xf0, 0xf0, 0xf0, 0x20, 0x01, 0xe0, 0x01, 0xb0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x41, 0xf0,
+    0x90, 0x04, 0xd0, 0x14, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x70, 0x31, 0x30, 0x04, 0xe0, 0x14, 0xd0,
+    0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf0, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0xf0, 0xa0, 0x24,
+    0x30, 0x23, 0x40, 0x44, 0x00, 0xf1, 0xf1, 0xf0, 0xf0, 0xf0, 0x60, 0x51, 0xf0, 0xf0, 0x20, 0xf1,
+    0xf1, 0xe0, 0x01, 0xe0, 0x01, 0xe0, 0x01, 0xe0, 0x01, 0xe0, 0x01, 0xe0, 0xf1, 0x01,
+};
+
+extern const size_t MARS_WORLD_SIZE = sizeof(MARS_WORLD);
@@ -1,9 +1,7 @@
 #include "mbed.h"
 #include "N5110.h"
-#include "Joystick.h"
 #include "games.h"
-#include <cstdlib>
-#include <ctime>
+#include "Random.h"
 
 // --- Game Constants ---
 static int score = 0;
@@ -18,8 +16,14 @@ static int combo = 0;
 static bool invincible = false;
 static int invincible_frames = 0;
 
+// The ship blinks while invincible: two frames shown, two hidden
+static const AnimFrame SHIP_BLINK_FRAMES[] = { { 1, 2 }, { 0, 2 } };
+static const AnimClip SHIP_BLINK = ANIM_CLIP(SHIP_BLINK_FRAMES);
+static Animation shipBlink;
+
 struct Projectile { int x, y; bool active; };
 static Projectile bullet = {0, 0, false};
+static Random rng;
 
 // --- Sprites ---
 const unsigned char ship[] = {
@@ -48,15 +52,98 @@ static void drawBitmap(N5110 &lcd, int x, int y, const unsigned char *bitmap, in
     }
 }
 
-static void drawHUD(N5110 &lcd) {
+// HUD text, re-formatted every frame or every HUD_SLOW_FRAMES when the
+// frame governor asks for less work
+static char hudText[3][8];
+static int hudAge = HUD_SLOW_FRAMES;
+
+static void drawHUD(N5110 &lcd, bool everyFrame) {
     lcd.drawLine(0, 0, 0, 47, FILL_BLACK);
     lcd.drawLine(50, 0, 50, 47, FILL_BLACK);
     lcd.drawLine(0, 47, 50, 47, FILL_BLACK);
-    
-    char buffer[16];
-    sprintf(buffer, "Lv:%d", level); lcd.printString(buffer, 52, 0);
-    sprintf(buffer, "Sp:%d", game_speed); lcd.printString(buffer, 52, 1);
-    sprintf(buffer, "Sc:%d", score); lcd.printString(buffer, 52, 2);
+
+    if (everyFrame || hudAge >= HUD_SLOW_FRAMES) {
+        sprintf(hudText[0], "Lv:%d", level);
+        sprintf(hudText[1], "Sp:%d", game_speed);
+        sprintf(hudText[2], "Sc:%d", score);
+        hudAge = 0;
+    }
+    hudAge++;
+    for (int i = 0; i < 3; i++) lcd.printString(hudText[i], 52, i);
+}
+
+// --- Effects ---
+// Purely visual, so they draw from their own generator: dropping them under
+// load never changes the game a recorded session replays.
+struct Particle { int x, y, dx, dy, life; };
+#define MAX_PARTICLES 16
+#define PARTICLES_PER_HIT 6
+static Particle *particles;  // MAX_PARTICLES, in the scene arena
+static Random fx;
+static const uint32_t FX_SEED = 0x5EED5EEDu;
+
+// Background stars falling through the playfield at three speeds, the
+// nearer the faster and the sparser
+static constexpr ParallaxStrip<64> FAR_STARS = star_strip<64>(0x51A2, 90, 0, HEIGHT - 1);
+static constexpr ParallaxStrip<64> MID_STARS = star_strip<64>(0x51A3, 50, 0, HEIGHT - 1);
+static constexpr ParallaxStrip<32> NEAR_STARS = star_strip<32>(0x51A4, 40, 0, HEIGHT - 1);
+static const ParallaxLayer STAR_LAYERS[] = {
+    PARALLAX_LAYER(FAR_STARS, 0, 128),
+    PARALLAX_LAYER(MID_STARS, 0, 256),
+    PARALLAX_LAYER(NEAR_STARS, 0, 512),
+};
+static Parallax starfield;
+static int starScroll = 0;
+
+static void resetEffects(Arena &arena) {
+    particles = arena.array<Particle>(MAX_PARTICLES);  // zero life, i.e. all free
+    fx.seed(FX_SEED);
+    starScroll = 0;
+    starfield.init(STAR_LAYERS, 3);
+    hudAge = HUD_SLOW_FRAMES;
+}
+
+static void explode(int x, int y) {
+    int spawned = 0;
+    for (int i = 0; i < MAX_PARTICLES && spawned < PARTICLES_PER_HIT; i++) {
+        Particle &p = particles[i];
+        if (p.life > 0) continue;
+        p.x = x;
+        p.y = y;
+        p.dx = fx.range(5) - 2;
+        p.dy = fx.range(4) - 3;
+        p.life = 4 + fx.range(4);
+        spawned++;
+    }
+}
+
+static void updateEffects(bool particlesOn) {
+    starScroll++;
+    for (int i = 0; i < MAX_PARTICLES; i++) {
+        Particle &p = particles[i];
+        if (p.life == 0) continue;
+        if (!particlesOn) {
+            p.life = 0;  // dropped by the governor - don't let them pop back later
+            continue;
+        }
+        p.x += p.dx;
+        p.y += p.dy;
+        p.dy++;
+        p.life--;
+    }
+}
+
+// Inside the playfield's border, on the screen just cleared
+static void drawStars(N5110 &lcd) {
+    starfield.scroll(0, starScroll);
+    starfield.draw(lcd, 1, 49);
+}
+
+static void drawParticles(N5110 &lcd) {
+    for (int i = 0; i < MAX_PARTICLES; i++) {
+        Particle const &p = particles[i];
+        if (p.life > 0 && p.x > 0 && p.x < 50) lcd.setPixel(p.x, p.y);
+    }
 }
 
 static void enemyShip(N5110 &lcd, int lane, int phase) {
@@ -70,163 +157,250 @@ static void playerShip(N5110 &lcd, int lane) {
 }
 
 // --- Transitions ---
-static void lightShow(N5110 &lcd, int lvl) {
-    for (int i = 0; i < 6; i++) {
-        lcd.clear();
-        if (i % 2 == 0) lcd.drawRect(0, 0, 84, 48, FILL_BLACK);
-        lcd.refresh();
-        ThisThread::sleep_for(100ms);
+// Ticks of the level-up flashing and of the banner that follows it
+static const int LIGHT_SHOW_FRAMES = 6;
+static const int BANNER_FRAMES = 12;
+// Game over returns to the menu on select, or by itself after this many ticks
+static const int GAME_OVER_FRAMES = 30;
+
+static bool paused = true;   // a script has the screen, the game waits
+static bool flash = false;   // light show frame filled black
+static bool quit = false;    // game over is done, back to the menu
+static char bannerText[sizeof("   LEVEL -2147483648")];
+
+static bool welcomeScript(Script &s, ScriptContext &ctx) {
+    SCRIPT_BEGIN(s);
+    SCRIPT_SAY(s, ctx, "Space Invaders\nPress select");
+    SCRIPT_WAIT_PRESS(s, ctx, BUTTON_SELECT);
+    ctx.close();
+    paused = false;
+    SCRIPT_END(s);
+}
+
+static bool levelUpScript(Script &s, ScriptContext &ctx) {
+    SCRIPT_BEGIN(s);
+    for (s.counter = 0; s.counter < LIGHT_SHOW_FRAMES; s.counter++) {
+        flash = s.counter % 2 == 0;
+        SCRIPT_YIELD(s);
     }
-    lcd.clear();
-    char buffer[16];
-    sprintf(buffer, "LEVEL %d", lvl);
-    lcd.printString(buffer, 18, 2);
-    lcd.refresh();
-    ThisThread::sleep_for(1200ms);
+    flash = false;
+    snprintf(bannerText, sizeof(bannerText), "   LEVEL %d", level);
+    SCRIPT_SAY(s, ctx, bannerText);
+    SCRIPT_WAIT_FRAMES(s, BANNER_FRAMES);
+    ctx.close();
+    paused = false;
+    SCRIPT_END(s);
+}
+
+static bool gameOverScript(Script &s, ScriptContext &ctx) {
+    SCRIPT_BEGIN(s);
+    SCRIPT_SAY(s, ctx, "  GAME OVER");
+    for (s.counter = 0; s.counter < GAME_OVER_FRAMES && !ctx.pressed(BUTTON_SELECT); s.counter++) {
+        SCRIPT_YIELD(s);
+    }
+    ctx.close();
+    quit = true;
+    SCRIPT_END(s);
 }
 
 // --- Level & Difficulty ---
-static void levelControl(N5110 &lcd) {
+// Returns true when the player has just gone up a level
+static bool levelControl() {
     static bool leveled_up = false;
-    static int previous_level = 0;
+    bool banner = false;
 
     if (score >= 10 && !leveled_up) {
         level++; score = 0;
-        lightShow(lcd, level);
+        banner = true;
         leveled_up = true;
     } else if (score < 10) {
         leveled_up = false;
     }
 
     game_speed = (level <= 5) ? level - 1 : 5;
-    previous_level = level;
+    return banner;
 }
 
-// --- Game Over ---
-static void gameOver(N5110 &lcd) {
-    while (true) {
-        lcd.clear();
-        lcd.printString("GAME OVER", 10, 3);
-        lcd.refresh();
-        ThisThread::sleep_for(400ms);
-    }
-}
+// --- Simulation & Drawing ---
+enum InvadersState { INVADERS_RUNNING, INVADERS_LEVEL_UP, INVADERS_GAME_OVER };
 
-// --- Main Game ---
-void spaceInvadeGame(N5110 &lcd, Joystick &joystick, DigitalIn &selectButton) {
-    // Reset game state
-    score = 0; level = 1; game_speed = 0;
-    enemy_phase = 0; enemy_dead = true;
-    playerLane = 2; control = true;
-    combo = 0; invincible = false; invincible_frames = 0;
-    bullet.active = false;
+// Simulation tick for each game_speed
+static const Kernel::Clock::duration GAME_TICKS[6] = { 80ms, 70ms, 60ms, 50ms, 40ms, 30ms };
 
-    srand(time(NULL));
+static InvadersState updateInvaders(InputFrame const &in) {
+    // Joystick input
+    Direction d = in.d;
+    if (d == W && playerLane > 1 && control) { playerLane--; control = false; }
+    else if (d == E && playerLane < 3 && control) { playerLane++; control = false; }
+    else if (d == CENTRE) { control = true; }
 
-    // Welcome screen
-    lcd.clear();
-    lcd.printString("Space Invaders", 0, 1);
-    lcd.printString("Press select", 0, 2);
-    lcd.refresh();
+    // Fire bullet
+    if ((in.buttons & BUTTON_JOY) && !bullet.active) {
+        bullet.x = (playerLane - 1) * 16 + 9;
+        bullet.y = 32;
+        bullet.active = true;
+    }
 
-    while (selectButton.read() == 1) ThisThread::sleep_for(100ms);
-    while (selectButton.read() == 0) ThisThread::sleep_for(50ms);
+    // Update bullet
+    if (bullet.active) {
+        bullet.y -= 2;
+        if (bullet.y < 0) bullet.active = false;
+    }
 
-    // Main loop
-    while (true) {
-        lcd.clear();
+    // Spawn enemies
+    if (enemy_dead) {
+        enemy_0_pos = playerLane;
+        enemy_1_pos = rng.range(3) + 1;
+        enemy_phase = 0;
+        enemy_dead = false;
+    }
+    enemy_phase++;
 
-        // Joystick input
-        Direction d = joystick.get_direction();
-        if (d == W && playerLane > 1 && control) { playerLane--; control = false; }
-        else if (d == E && playerLane < 3 && control) { playerLane++; control = false; }
-        else if (d == CENTRE) { control = true; }
-
-        // Fire bullet
-        if (joystick.button_pressed() && !bullet.active) {
-            bullet.x = (playerLane - 1) * 16 + 9;
-            bullet.y = 32;
-            bullet.active = true;
+    // Bullet collision with enemy
+    if (bullet.active && enemy_phase <= bullet.y + 4) {
+        int bullet_lane = bullet.x < 15 ? 1 : bullet.x < 31 ? 2 : 3;
+        if (bullet_lane == enemy_0_pos || bullet_lane == enemy_1_pos) {
+            score++; combo++;
+            explode((bullet_lane - 1) * 16 + 9, enemy_phase + 7);
+            if (combo >= 3) {
+                invincible = true;
+                invincible_frames = 100;
+                shipBlink.play(SHIP_BLINK);
+            }
+            enemy_dead = true;
+            bullet.active = false;
         }
+    }
 
-        // Update bullet
-        if (bullet.active) {
-            bullet.y -= 2;
-            if (bullet.y < 0) bullet.active = false;
-            else lcd.drawRect(bullet.x, bullet.y, 2, 4, FILL_BLACK);
+    // Invincibility decay
+    if (invincible) {
+        invincible_frames--;
+        shipBlink.tick();
+        if (invincible_frames <= 0) {
+            invincible = false;
+            shipBlink.stop();
+            combo = 0;
         }
+    }
 
-        // Draw player ship
-        if (!invincible || (invincible_frames % 4 < 2)) {
-            playerShip(lcd, playerLane);
-        }
+    // Collision with enemy
+    if (!invincible && enemy_phase > 22 && (enemy_0_pos == playerLane || enemy_1_pos == playerLane)) {
+        return INVADERS_GAME_OVER;
+    }
 
-        // Spawn enemies
-        if (enemy_dead) {
-            enemy_0_pos = playerLane;
-            enemy_1_pos = (rand() % 3) + 1;
-            enemy_phase = 0;
-            enemy_dead = false;
-        }
+    // Missed enemy
+    if (enemy_phase > 40) {
+        enemy_dead = true;
+        score++;
+    }
+
+    return levelControl() ? INVADERS_LEVEL_UP : INVADERS_RUNNING;
+}
+
+static void drawInvaders(N5110 &lcd, bool stars, bool sparks, bool hudEveryFrame) {
+    lcd.clear();
+
+    if (stars) drawStars(lcd);
+
+    if (bullet.active) {
+        lcd.drawRect(bullet.x, bullet.y, 2, 4, FILL_BLACK);
+    }
+
+    // Player ship blinks while invincible
+    if (!invincible || shipBlink.image()) {
+        playerShip(lcd, playerLane);
+    }
 
-        // Draw enemies
+    if (!enemy_dead) {
         enemyShip(lcd, enemy_0_pos, enemy_phase);
         enemyShip(lcd, enemy_1_pos, enemy_phase);
-        enemy_phase++;
-
-        // Bullet collision with enemy
-        if (bullet.active && enemy_phase <= bullet.y + 4) {
-            int bullet_lane = bullet.x < 15 ? 1 : bullet.x < 31 ? 2 : 3;
-            if (bullet_lane == enemy_0_pos || bullet_lane == enemy_1_pos) {
-                score++; combo++;
-                if (combo >= 3) {
-                    invincible = true;
-                    invincible_frames = 100;
-                }
-                enemy_dead = true;
-                bullet.active = false;
-            }
-        }
+    }
 
-        // Invincibility decay
-        if (invincible) {
-            invincible_frames--;
-            if (invincible_frames <= 0) {
-                invincible = false;
-                combo = 0;
-            }
-        }
+    if (sparks) drawParticles(lcd);
+    drawHUD(lcd, hudEveryFrame);
+}
 
-        // Collision with enemy
-        if (!invincible && enemy_phase > 22 && (enemy_0_pos == playerLane || enemy_1_pos == playerLane)) {
-            gameOver(lcd);
-        }
+// --- Main Game ---
+InvadersScene::InvadersScene(InputSource &input)
+    : Scene("Invaders"), input(input) { }
 
-        // Missed enemy
-        if (enemy_phase > 40) {
-            enemy_dead = true;
-            score++;
-        }
+void InvadersScene::enter() {
+    // Reset game state
+    score = 0; level = 1; game_speed = 0;
+    enemy_phase = 0; enemy_dead = true;
+    playerLane = 2; control = true;
+    combo = 0; invincible = false; invincible_frames = 0;
+    shipBlink.stop();
+    bullet.active = false;
+    resetEffects(arena());
 
-        // Update level and UI
-        levelControl(lcd);
-        drawHUD(lcd);
-        lcd.refresh();
-
-        // Adjust game speed
-        switch (game_speed) {
-            case 0: ThisThread::sleep_for(80ms); break;
-            case 1: ThisThread::sleep_for(70ms); break;
-            case 2: ThisThread::sleep_for(60ms); break;
-            case 3: ThisThread::sleep_for(50ms); break;
-            case 4: ThisThread::sleep_for(40ms); break;
-            default: ThisThread::sleep_for(30ms); break;
-        }
+    rng.seed(input.begin_session());
 
-        // Exit game
-        if (selectButton.read() == 0) {
-            while (selectButton.read() == 0) ThisThread::sleep_for(50ms);
+    paused = true;
+    flash = false;
+    quit = false;
+    scripts.init(arena(), 2);
+    scripts.start(welcomeScript);
+}
+
+void InvadersScene::update(InputFrame const &in, uint8_t pressed) {
+    // scripts hold the game, including the tick they finish on
+    bool held = paused;
+    ctx.set_input(in, pressed);
+    scripts.run(ctx);
+    if (quit) {
+        change(SCENE_MENU);
+        return;
+    }
+    if (held) return;
+
+    // Exit game
+    if (pressed & BUTTON_SELECT) {
+        change(SCENE_MENU);
+        return;
+    }
+    updateEffects(quality(QUALITY_PARTICLES));
+    switch (updateInvaders(in)) {
+        case INVADERS_LEVEL_UP:
+            paused = true;
+            scripts.start(levelUpScript);
             break;
-        }
+        case INVADERS_GAME_OVER:
+            paused = true;
+            scripts.start(gameOverScript);
+            break;
+        default:
+            break;
+    }
+}
+
+// The game itself; particles and the stars depend on the frame budget so stay out
+uint32_t InvadersScene::state() const {
+    uint32_t hash = state_mix(score, level);
+    hash = state_mix(hash, enemy_phase << 16 | enemy_0_pos << 8 | enemy_1_pos);
+    hash = state_mix(hash, playerLane << 8 | enemy_dead << 1 | invincible);
+    hash = state_mix(hash, bullet.active ? bullet.x << 8 | bullet.y : 0);
+    hash = state_mix(hash, combo);
+    return state_mix(hash, rng.get_state());
+}
+
+void InvadersScene::draw(N5110 &lcd) {
+    if (!paused) {
+        drawInvaders(lcd, quality(QUALITY_BACKGROUND), quality(QUALITY_PARTICLES),
+                     quality(QUALITY_HUD));
+    } else {
+        lcd.clear();
+        if (flash) lcd.drawRect(0, 0, 84, 48, FILL_BLACK);
     }
+    ctx.draw(lcd, 2);
+}
+
+void InvadersScene::exit() {
+    input.end_session();
+}
+
+// Game speed is the simulation tick, independent of how long drawing takes.
+// Scripts count their waits at 10 ticks a second.
+Kernel::Clock::duration InvadersScene::tick() const {
+    return paused ? 100ms : GAME_TICKS[game_speed];
 }
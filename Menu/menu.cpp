@@ -1,43 +1,86 @@
 #include "menu.h"
 
-const int NUM_OPTIONS = 4;
-const char* menuOptionsStr[NUM_OPTIONS] = { "Mars Explorer", "Space Invader", "Map Editor", "   Exit   " };
-int selected = 0;
+static const int NUM_OPTIONS = 4;
+static const char* menuOptionsStr[NUM_OPTIONS] = { "Mars Explorer", "Space Invader", "Map Editor", "   Exit   " };
+static const SceneId menuTargets[NUM_OPTIONS] = { SCENE_EXPLORE, SCENE_INVADERS, SCENE_EDITOR, SCENE_EXIT };
 
-void showMainMenu(N5110 &lcd, Joystick &joystick, DigitalIn &selectButton) {
-    const int menuStartRow = 1;
-    selected = 0;
-    bool inMenu = true;
-    while (inMenu) {
-        lcd.clear();
-        // Print menu options
-        for (int i = 0; i < NUM_OPTIONS; i++) {
-            lcd.printString(menuOptionsStr[i], 0, menuStartRow + i);
-        }
+// Frames to wait before a held stick moves the selection again
+static const int MENU_REPEAT_FRAMES = 2;
 
-        // Handle joystick navigation
-        Direction d = joystick.get_direction();
-        if (d == N) {
-            selected--;
-            if (selected < 0) selected = NUM_OPTIONS - 1;
-            ThisThread::sleep_for(200ms);
-        } else if (d == S) {
-            selected++;
-            if (selected >= NUM_OPTIONS) selected = 0;
-            ThisThread::sleep_for(200ms);
-        }
+MenuScene::MenuScene(InputSource &input)
+    : Scene("Menu"), input(input), selected(0), repeatDelay(0), redraw(true),
+      restoreMode(false), mode(InputSource::INPUT_LIVE) { }
 
-        // Highlight the current option using a transparent rectangle
-        lcd.drawRect(0, (menuStartRow + selected) * 8, 84, 8, FILL_TRANSPARENT);
-        lcd.refresh();
+void MenuScene::enter() {
+    // back from a forced replay
+    if (restoreMode) {
+        input.set_mode(mode);
+        restoreMode = false;
+    }
+    selected = 0;
+    repeatDelay = 0;
+    redraw = true;
+    preload_scene(menuTargets[selected]);
+}
 
-        // Check if the select button is pressed to confirm a choice
-        if (selectButton.read() == 0) {
-            while (selectButton.read() == 0) { 
-                ThisThread::sleep_for(50ms); 
-            }
-            inMenu = false;
+void MenuScene::update(InputFrame const &in, uint8_t pressed) {
+    // Handle joystick navigation
+    Direction d = in.d;
+    int previous = selected;
+    if (repeatDelay > 0) {
+        repeatDelay--;
+    } else if (d == N) {
+        selected--;
+        if (selected < 0) selected = NUM_OPTIONS - 1;
+        repeatDelay = MENU_REPEAT_FRAMES;
+    } else if (d == S) {
+        selected++;
+        if (selected >= NUM_OPTIONS) selected = 0;
+        repeatDelay = MENU_REPEAT_FRAMES;
+    }
+    if (selected != previous) {
+        redraw = true;
+        // get the highlighted scene ready while the player decides
+        preload_scene(menuTargets[selected]);
+    }
+
+    // Check if the select button is pressed to confirm a choice
+    if (pressed & BUTTON_SELECT) {
+        // Holding the joystick button while choosing replays the last recording
+        if (in.buttons & BUTTON_JOY) {
+            mode = input.get_mode();
+            restoreMode = true;
+            input.set_mode(InputSource::INPUT_REPLAY);
         }
-        ThisThread::sleep_for(100ms);
+        change(menuTargets[selected]);
+    }
+}
+
+void MenuScene::draw(N5110 &lcd) {
+    const int menuStartRow = 1;
+    lcd.clear();
+    // Print menu options
+    for (int i = 0; i < NUM_OPTIONS; i++) {
+        lcd.printString(menuOptionsStr[i], 0, menuStartRow + i);
     }
+
+    // Highlight the current option using a transparent rectangle
+    lcd.drawRect(0, (menuStartRow + selected) * 8, 84, 8, FILL_TRANSPARENT);
+    redraw = false;
 }
+
+bool MenuScene::dirty() const { return redraw; }
+
+ExitScene::ExitScene() : Scene("Exit"), redraw(true) { }
+
+void ExitScene::enter() { redraw = true; }
+
+void ExitScene::update(InputFrame const &in, uint8_t pressed) { }
+
+void ExitScene::draw(N5110 &lcd) {
+    lcd.clear();
+    lcd.printString("Exiting...", 0, 3);
+    redraw = false;
+}
+
+bool ExitScene::dirty() const { return redraw; }
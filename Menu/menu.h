@@ -3,12 +3,40 @@
 
 #include "mbed.h"
 #include "N5110.h"
-#include "Joystick.h"
+#include "InputSource.h"
+#include "Scene.h"
 
-extern int selected;
-extern const int NUM_OPTIONS;
-extern const char* menuOptionsStr[];
+/// Main menu - picks the next scene, holding the joystick button replays it
+class MenuScene : public Scene {
+public:
+    MenuScene(InputSource &input);
 
-void showMainMenu(N5110 &lcd, Joystick &joystick, DigitalIn &selectButton);
+    void enter() override;
+    void update(InputFrame const &in, uint8_t pressed) override;
+    void draw(N5110 &lcd) override;
+    bool dirty() const override;
+
+private:
+    InputSource &input;
+    int selected;
+    int repeatDelay;
+    bool redraw;
+    bool restoreMode;          // a replay was forced from the menu
+    InputSource::Mode mode;    // mode to go back to afterwards
+};
+
+/// Shown once Exit is chosen, the board then idles with the backlight off
+class ExitScene : public Scene {
+public:
+    ExitScene();
+
+    void enter() override;
+    void update(InputFrame const &in, uint8_t pressed) override;
+    void draw(N5110 &lcd) override;
+    bool dirty() const override;
+
+private:
+    bool redraw;
+};
 
 #endif
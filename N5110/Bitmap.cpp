@@ -1,8 +1,9 @@
 #include <iostream>
 #include "N5110.h"
 #include "Bitmap.h"
+#include "Arena.h"
 
-Bitmap::Bitmap(int const *contents, unsigned int const height, unsigned int const width): _contents(std::vector<int>(height*width)), _height(height), _width(width){
+Bitmap::Bitmap(int const *contents, unsigned int const height, unsigned int const width): _contents(std::vector<int>(height*width)), _arenaContents(nullptr), _height(height), _width(width){
     
     //Perform a quick sanity check of the dimensions
     if (_contents.size() != height * width) {
@@ -14,6 +15,10 @@ Bitmap::Bitmap(int const *contents, unsigned int const height, unsigned int cons
     for(unsigned int i = 0; i < height*width; ++i) _contents[i] = contents[i];
 }
 
+Bitmap::Bitmap(int const *contents, unsigned int const height, unsigned int const width, Arena &arena): _arenaContents(arena.array<int>(height*width)), _height(height), _width(width){
+    for(unsigned int i = 0; i < height*width; ++i) _arenaContents[i] = contents[i];
+}
+
 //returns the value of the pixel at the given position
 int Bitmap::get_pixel(unsigned int const row, unsigned int const column) const{
     
@@ -24,7 +29,9 @@ int Bitmap::get_pixel(unsigned int const row, unsigned int const column) const{
                   << _height << std::endl;
     }
 
-    return _contents[row * _width + column];    // Now return the pixel value, using row-major indexing
+    // Now return the pixel value, using row-major indexing
+    if (_arenaContents) return _arenaContents[row * _width + column];
+    return _contents[row * _width + column];
 }
 
 //Prints the contents of the bitmap to the terminal
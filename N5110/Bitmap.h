@@ -5,14 +5,18 @@
 
 // Forward declarations
 class N5110;
+class Arena;
 class Bitmap{
 private:
-    std::vector<int> _contents;
+    std::vector<int> _contents;     // heap copy of the pixels, or
+    int *_arenaContents;            // a copy in an Arena
     unsigned int _height;       // The height of the drawing in pixels
     unsigned int _width;        // The width of the drawing in pixels
     
 public:
     Bitmap(int const *contents, unsigned int const height, unsigned int const width);
+    // keeps the pixels in arena instead of on the heap, valid until the arena is reset
+    Bitmap(int const *contents, unsigned int const height, unsigned int const width, Arena &arena);
     int get_pixel(unsigned int const row, unsigned int const column) const;
     void print() const;
     void render(N5110 &lcd, unsigned int const x0, unsigned int const y0) const;
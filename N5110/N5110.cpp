@@ -20,7 +20,10 @@ N5110::N5110(PinName const pwrPin,
     _pwr(new DigitalOut(pwrPin)),
     _sce(new DigitalOut(scePin)),
     _rst(new DigitalOut(rstPin)),
-    _dc(new DigitalOut(dcPin))
+    _dc(new DigitalOut(dcPin)),
+    _backlightAsleep(false),
+    _shownValid(false),
+    _partialFlush(false)
 {}
 
 // overloaded constructor does not include power pin - LCD Vcc must be tied to +3V3
@@ -38,7 +41,10 @@ N5110::N5110(PinName const scePin,
     _pwr(NULL), // pwr not needed so null it to be safe
     _sce(new DigitalOut(scePin)),
     _rst(new DigitalOut(rstPin)),
-    _dc(new DigitalOut(dcPin))
+    _dc(new DigitalOut(dcPin)),
+    _backlightAsleep(false),
+    _shownValid(false),
+    _partialFlush(false)
 {}
 
 N5110::~N5110(){
@@ -121,6 +127,13 @@ void N5110::setBrightness(float brightness){
     _led->write(brightness);    // set PWM duty cycle
 }
 
+void N5110::sleepBacklight(bool const sleep){
+    if (sleep == _backlightAsleep) return;
+    if (sleep) _led->suspend();   // releases the deep sleep lock held by the PWM
+    else       _led->resume();
+    _backlightAsleep = sleep;
+}
+
 void N5110::setContrast(float contrast) {
     
     // enforce limits
@@ -211,6 +224,7 @@ void N5110::sendData(unsigned char data){
 
 // this function writes 0 to the 504 bytes to clear the RAM
 void N5110::clearRAM(){
+    _shownValid = false;                        // the display no longer holds the last frame
     _sce->write(0);                             //set CE low to begin frame
     for(int i = 0; i < WIDTH * HEIGHT; i++) {   // 48 x 84 bits = 504 bytes
         _spi->write(0x00);                      // send 0's
@@ -263,20 +277,89 @@ int N5110::getPixel(unsigned int const x, unsigned int const y) const{
 
 // function to refresh the display
 void N5110::refresh(){
-    setXYAddress(0,0);  // important to set address back to 0,0 before refreshing display
-                        // address auto increments after printing string, so buffer[0][0] will not coincide
-                        // with top-left pixel after priting string
-    _sce->write(0);     //set CE low to begin frame
+    unsigned char frame[FRAME_BYTES];
+    copyFrame(frame);
+    if (_presenter) {
+        _presenter(frame);
+        return;
+    }
+    sendFrame(frame);
+}
+
+void N5110::attachPresenter(Callback<void(unsigned char const *)> presenter){
+    _presenter = presenter;
+}
 
-    // be careful to use correct order (j,i) for horizontal addressing
+// reorder the column-major buffer into the bank-major order used by refresh()
+void N5110::copyFrame(unsigned char *frame) const{
     for(int j = 0; j < BANKS; j++) {
         for(int i = 0; i < WIDTH; i++) {
-            _spi->write(buffer[i][j]);      // send buffer
+            *frame++ = buffer[i][j];
         }
     }
-    _sce->write(1); // set CE high to end frame
 }
 
+void N5110::sendFrame(unsigned char const *frame){
+    if (_partialFlush && _shownValid) {
+        // per bank, resend only the columns between the first and last change
+        for(int j = 0; j < BANKS; j++) {
+            unsigned char const *row = frame + j * WIDTH;
+            unsigned char const *shown = _shown + j * WIDTH;
+            int first = 0;
+            int last = WIDTH - 1;
+            while (first < WIDTH && row[first] == shown[first]) first++;
+            if (first == WIDTH) continue;    // bank unchanged
+            while (row[last] == shown[last]) last--;
+
+            setXYAddress(first, j);
+            _sce->write(0);
+            sendSpan(row + first, last - first + 1);
+            _sce->write(1);
+        }
+    } else {
+        setXYAddress(0,0);  // address auto increments, so always start from the top-left
+        _sce->write(0);     //set CE low to begin frame
+        sendSpan(frame, FRAME_BYTES);
+        _sce->write(1); // set CE high to end frame
+    }
+
+    memcpy(_shown, frame, FRAME_BYTES);
+    _shownValid = true;
+}
+
+void N5110::sendSpan(unsigned char const *data, int const length){
+#if DEVICE_SPI_ASYNCH
+    // one interrupt-driven transfer - other threads run until it completes
+    _spiDone.clear();
+    _spi->transfer<unsigned char>(data, length, NULL, 0,
+                                  event_callback_t(this, &N5110::onTransferDone), SPI_EVENT_COMPLETE);
+    _spiDone.wait_any(1);
+#else
+    for(int i = 0; i < length; i++) {
+        _spi->write(data[i]);
+    }
+#endif
+}
+
+void N5110::blitBank(int const x, unsigned int const bank, unsigned char const *columns, int const width){
+    if (bank >= BANKS) return;
+    int first = x < 0 ? -x : 0;                      // clip on the left
+    int last = x + width > WIDTH ? WIDTH - x : width; // and on the right
+    for (int i = first; i < last; i++) {
+        buffer[x + i][bank] = columns[i];
+    }
+}
+
+void N5110::setPartialFlush(bool const partial){
+    _partialFlush = partial;
+}
+
+#if DEVICE_SPI_ASYNCH
+void N5110::onTransferDone(int event){
+    _spiDone.set(1);
+}
+#endif
+
 // fills the buffer with random bytes.  Can be used to test the display.
 // The rand() function isn't seeded so it probably creates the same pattern everytime
 void N5110::randomiseBuffer(){
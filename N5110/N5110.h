@@ -21,6 +21,7 @@
 #define WIDTH 84
 #define HEIGHT 48
 #define BANKS 6
+#define FRAME_BYTES (WIDTH * BANKS)
 
 /// Fill types for 2D shapes
 enum FillType {
@@ -47,6 +48,14 @@ private:
 
 // variables
     unsigned char buffer[84][6];  // screen buffer - the 6 is for the banks - each one is 8 bits;
+    Callback<void(unsigned char const *)> _presenter;  // takes over refresh() when attached
+    bool _backlightAsleep;
+    unsigned char _shown[FRAME_BYTES];  // last frame sent, for partial flushes
+    bool _shownValid;
+    bool _partialFlush;
+#if DEVICE_SPI_ASYNCH
+    EventFlags _spiDone;          // set from the SPI interrupt when a frame has been sent
+#endif
 
 public:
     //Create a N5110 object connected to the specified pins
@@ -99,6 +108,12 @@ public:
     *   @param brightness - float in range 0.0 to 1.0*/
     void setBrightness(float const brightness);
 
+    /* Sleep backlight
+    *   A running PWM keeps the MCU out of deep sleep. sleepBacklight(true) suspends the PWM, turning
+    *   the backlight off, so an idle screen can sit in deep sleep; sleepBacklight(false) resumes it
+    *   at the previous brightness.*/
+    void sleepBacklight(bool const sleep);
+
     /* Print String
     *   Prints a string of characters to the screen buffer. String is cut-off after the 83rd pixel.
     *   @param x - the column number (0 to 83)
@@ -144,6 +159,38 @@ public:
     *   This functions sends the screen buffer to the display.*/
     void refresh();
 
+    /* Attach presenter
+    *   Once attached, refresh() copies the screen buffer in display order (see copyFrame) and hands it
+    *   to the presenter instead of sending it itself, e.g. so a display thread can send frame N
+    *   while frame N+1 is being drawn. The presenter is responsible for calling sendFrame().*/
+    void attachPresenter(Callback<void(unsigned char const *)> presenter);
+
+    /* Copy frame
+    *   Copies the screen buffer into frame (FRAME_BYTES long) in the order the display expects it:
+    *   bank 0 columns 0 to 83, then bank 1 and so on.*/
+    void copyFrame(unsigned char *frame) const;
+
+    /* Send frame
+    *   Sends a frame produced by copyFrame() to the display. Where the target supports
+    *   asynchronous SPI the calling thread sleeps while the transfer runs.*/
+    void sendFrame(unsigned char const *frame);
+
+    /* Blit bank
+    *   Copies width column bytes (bit 0 at the top) into one bank of the buffer starting at pixel
+    *   column x, replacing what was there. Columns left or right of the screen are clipped, so x
+    *   may be negative. This is how bank-aligned tiles are drawn, 8 bytes at a time.
+    *   @param  x       - pixel column of the first byte
+    *   @param  bank    - bank (0 to 5), i.e. pixel rows 8*bank to 8*bank+7
+    *   @param  columns - the column bytes
+    *   @param  width   - number of columns*/
+    void blitBank(int const x, unsigned int const bank, unsigned char const *columns, int const width);
+
+    /* Set partial flush
+    *   With partial flush on, sendFrame() compares the frame with the last one sent and, for each
+    *   bank, only sends the run of columns from the first to the last one that changed. Frames
+    *   that change little take a fraction of the SPI time. Off by default.*/
+    void setPartialFlush(bool const partial);
+
     /* Randomise buffer
     *   This function fills the buffer with random data.  Can be used to test the display.
     *   A call to refresh() must be made to update the display to reflect the change in pixels.
@@ -195,6 +242,7 @@ public:
 
 private:
 // methods
+    void sendSpan(unsigned char const *data, int const length);
     void setXYAddress(unsigned int const x,
                       unsigned int const y);
     void initSPI(LCD_Type const lcd); // LCD type is passed to enable SPI mode modification -> functionality added byt Dr Tim Amsdon Feb 2022
@@ -205,6 +253,9 @@ private:
     void sendData(unsigned char data);
     void setTempCoefficient(char tc);           // 0 to 3
     void setBias(char bias);                    // 0 to 7
+#if DEVICE_SPI_ASYNCH
+    void onTransferDone(int event);
+#endif
 };
 
 const unsigned char font5x7[480] = {
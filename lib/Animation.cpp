@@ -0,0 +1,23 @@
+#include "Animation.h"
+
+Animation::Animation() : _clip(nullptr), _frame(0), _left(0) { }
+
+void Animation::play(AnimClip const &clip) {
+    _clip = &clip;
+    _frame = 0;
+    _left = clip.frames[0].ticks;
+}
+
+void Animation::stop() { _clip = nullptr; }
+
+bool Animation::tick() {
+    if (!_clip || --_left > 0) return false;
+    uint8_t before = _clip->frames[_frame].image;
+    _frame = (_frame + 1) % _clip->count;
+    _left = _clip->frames[_frame].ticks;
+    return _clip->frames[_frame].image != before;
+}
+
+uint8_t Animation::image() const { return _clip ? _clip->frames[_frame].image : 0; }
+
+bool Animation::playing() const { return _clip != nullptr; }
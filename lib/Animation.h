@@ -0,0 +1,63 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include "mbed.h"
+
+/// One frame of a clip: an image, whatever the clip's user takes that to mean,
+/// held for a number of ticks
+struct AnimFrame {
+    uint8_t image;
+    uint8_t ticks;  // at least 1
+};
+
+/// A looping sequence of frames, kept in flash
+struct AnimClip {
+    AnimFrame const *frames;
+    uint8_t count;
+};
+
+// An AnimClip over a const AnimFrame array
+#define ANIM_CLIP(frames) { frames, sizeof(frames) / sizeof(frames[0]) }
+
+/** Animation Class
+@brief A clip playing on one sprite, a tick at a time
+
+Clips are data: the frames and how long each is held live in flash, and an
+Animation only keeps its place in one, so a sprite costs three bytes and a
+pointer. tick() says whether the image changed, which is all a scene that
+redraws on change needs to know.
+
+Example:
+
+@code
+
+static const AnimFrame BLINK_FRAMES[] = { { 1, 2 }, { 0, 2 } };  // shown, hidden
+static const AnimClip BLINK = ANIM_CLIP(BLINK_FRAMES);
+
+Animation blink;
+blink.play(BLINK);
+...
+redraw |= blink.tick();
+if (blink.image()) drawShip(lcd);
+
+@endcode
+*/
+class Animation
+{
+public:
+    Animation();
+
+    void play(AnimClip const &clip);  // from its first frame
+    void stop();                      // image() is 0 until the next play()
+    bool tick();                      // true if the image changed
+
+    uint8_t image() const;
+    bool playing() const;
+
+private:
+    AnimClip const *_clip;
+    uint8_t _frame;
+    uint8_t _left;  // ticks until the next frame
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include "Arena.h"
+
+Arena::Arena(void *memory, size_t size, char const *name)
+    : _base(static_cast<uint8_t *>(memory)), _size(size), _top(0), _high(0), _name(name) { }
+
+void *Arena::allocate(size_t bytes, size_t align) {
+    uintptr_t start = reinterpret_cast<uintptr_t>(_base) + _top;
+    start = (start + align - 1) & ~(uintptr_t)(align - 1);
+    size_t offset = start - reinterpret_cast<uintptr_t>(_base);
+    if (offset + bytes > _size) {
+        error("Arena %s: %u bytes asked for, %u of %u left\n", _name,
+              (unsigned)bytes, (unsigned)(_size - _top), (unsigned)_size);
+        return nullptr;
+    }
+
+    _top = offset + bytes;
+    if (_top > _high) _high = _top;
+    void *p = _base + offset;
+    memset(p, 0, bytes);
+    return p;
+}
+
+void Arena::reset() { _top = 0; }
+
+size_t Arena::used() const { return _top; }
+
+size_t Arena::capacity() const { return _size; }
+
+size_t Arena::high_water() const { return _high; }
+
+void Arena::reset_high_water() { _high = _top; }
+
+void Arena::report() const {
+    printf("Arena %s: %u of %u bytes in use, high water %u\n", _name,
+           (unsigned)_top, (unsigned)_size, (unsigned)_high);
+}
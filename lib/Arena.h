@@ -0,0 +1,103 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "mbed.h"
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+
+/** Arena Class
+@brief Bump allocator over a fixed block of memory, emptied in one step
+
+Allocations are carved off the front of the block in order and are never
+freed one by one: reset() gives the whole block back at once by moving the
+top back to the start, so nothing fragments however often it is refilled.
+That suits data that lives exactly as long as a scene or a game session.
+
+Only trivial types (plain structs, arrays of numbers) can be stored, since
+nothing is destructed on reset(); they come back zero-filled. Running out of
+space is a sizing bug rather than a runtime condition, so it halts with
+error() naming the arena.
+
+The high-water mark is the most the arena has held since the last
+reset_high_water(), which is what its block needs to be at least.
+
+Example:
+
+@code
+
+static uint8_t memory[1024];
+Arena arena(memory, sizeof(memory), "Level");
+
+Enemy *enemies = arena.array<Enemy>(16);
+FixedArray<Particle> sparks(arena, 32);
+...
+arena.reset();
+
+@endcode
+*/
+class Arena
+{
+public:
+    Arena(void *memory, size_t size, char const *name);
+
+    void *allocate(size_t bytes, size_t align);  // zero-filled, halts when out of space
+    void reset();                                // O(1): everything allocated is gone
+
+    template <typename T>
+    T *array(size_t count) {
+        static_assert(std::is_trivial<T>::value, "arenas don't run constructors or destructors");
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    size_t used() const;
+    size_t capacity() const;
+    size_t high_water() const;
+    void reset_high_water();
+    void report() const;
+
+private:
+    uint8_t *_base;
+    size_t _size;
+    size_t _top;
+    size_t _high;
+    char const *_name;
+};
+
+/// Fixed-capacity list stored in an Arena
+template <typename T>
+class FixedArray
+{
+public:
+    FixedArray() : _data(nullptr), _capacity(0), _size(0) { }
+    FixedArray(Arena &arena, size_t capacity) { init(arena, capacity); }
+
+    void init(Arena &arena, size_t capacity) {
+        _data = arena.array<T>(capacity);
+        _capacity = capacity;
+        _size = 0;
+    }
+
+    bool push_back(T const &value) {   // false when full
+        if (_size == _capacity) return false;
+        _data[_size++] = value;
+        return true;
+    }
+    void remove(size_t i) {            // order not kept: the last element fills the gap
+        _data[i] = _data[--_size];
+    }
+    void clear() { _size = 0; }
+
+    T &operator[](size_t i) { return _data[i]; }
+    T const &operator[](size_t i) const { return _data[i]; }
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool full() const { return _size == _capacity; }
+
+private:
+    T *_data;
+    size_t _capacity;
+    size_t _size;
+};
+
+#endif
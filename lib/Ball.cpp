@@ -1,4 +1,5 @@
 #include "Ball.h"
+#include "Log.h"
 
 Ball::Ball() {}
 
@@ -24,13 +25,13 @@ void Ball::update(){
 }
 
 void Ball::set_velocity(Position2D v){
-    printf("Ball: Velocity\n");
+    LOG_TRACE(LOG_BALL_VELOCITY, v.x, v.y);
     _velocity.x = v.x;
     _velocity.y = v.y;
 }
 
 void Ball::set_pos(Position2D p) {
-    printf("Ball: Set Position\n");
+    LOG_TRACE(LOG_BALL_POSITION, p.x, p.y);
     _x = p.x;
     _y = p.y;
 }
@@ -0,0 +1,15 @@
+#include "Chunk.h"
+
+bool chunk_decode(uint8_t const *data, size_t length, Chunk &chunk) {
+    int tile = 0;
+    for (size_t i = 0; i < length; i++) {
+        int run = (data[i] >> 4) + 1;
+        uint8_t id = data[i] & 0x0F;
+        if (id >= TILE_TYPE_COUNT || tile + run > CHUNK_TILES) return false;
+
+        for (; run > 0; run--, tile++) {
+            chunk.set(tile % CHUNK_WIDTH, tile / CHUNK_WIDTH, id);
+        }
+    }
+    return tile == CHUNK_TILES;
+}
@@ -0,0 +1,28 @@
+#ifndef CHUNK_H
+#define CHUNK_H
+
+#include "mbed.h"
+#include "TileMap.h"
+
+// Streamed worlds are cut into strips this many columns wide, full height
+#define CHUNK_SHIFT 4
+#define CHUNK_WIDTH (1 << CHUNK_SHIFT)
+#define CHUNK_TILES (CHUNK_WIDTH * MAP_HEIGHT)
+
+// Largest compressed chunk: every run one tile long
+#define CHUNK_MAX_BYTES CHUNK_TILES
+
+/// One decompressed chunk
+typedef TileGrid<CHUNK_WIDTH> Chunk;
+
+/*
+ * Chunks are compressed as runs over their tiles in row order, one byte per
+ * run: the high nibble is the run length minus one (1-16 tiles), the low
+ * nibble the tile ID. tools/worldpack.py writes the same format.
+ *
+ * Decoding fails, leaving the chunk partly filled, unless the runs cover the
+ * chunk exactly with valid tile IDs.
+ */
+bool chunk_decode(uint8_t const *data, size_t length, Chunk &chunk);
+
+#endif
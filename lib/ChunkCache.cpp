@@ -0,0 +1,115 @@
+#include "ChunkCache.h"
+
+ChunkCache::ChunkCache()
+    : _source(nullptr), _chunks(nullptr), _index(nullptr), _used(nullptr), _slots(0),
+      _clock(0), _last(0), _loads(0), _prefetches(0), _failures(0) { }
+
+void ChunkCache::init(Arena &arena, int slots, ChunkSource &source, int edits) {
+    // the viewport can span two chunks, plus one being prefetched
+    if (slots < 3) error("ChunkCache: %d slots, need at least 3\n", slots);
+
+    _source = &source;
+    _chunks = arena.array<Chunk>(slots);
+    _index = arena.array<int16_t>(slots);
+    _used = arena.array<uint32_t>(slots);
+    _slots = slots;
+    for (int i = 0; i < slots; i++) _index[i] = -1;
+    _edits.init(arena, edits);
+    _clock = 0;
+    _last = 0;
+    _loads = _prefetches = _failures = 0;
+}
+
+int ChunkCache::width() const {
+    return _source ? _source->chunk_count() * CHUNK_WIDTH : 0;
+}
+
+int ChunkCache::slot_of(int index) const {
+    if (_index[_last] == index) return _last;
+    for (int i = 0; i < _slots; i++) {
+        if (_index[i] == index) return i;
+    }
+    return -1;
+}
+
+// Decompress a chunk into the least recently used slot
+int ChunkCache::load(int index) {
+    int slot = 0;
+    for (int i = 1; i < _slots; i++) {
+        if (_used[i] < _used[slot]) slot = i;
+    }
+
+    Chunk &chunk = _chunks[slot];
+    chunk.clear();
+    if (!_source->load(index, chunk)) {
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            for (int x = 0; x < CHUNK_WIDTH; x++) chunk.set(x, y, TILE_WALL);
+        }
+        _failures++;
+    }
+    apply_edits(index, chunk);
+    _index[slot] = index;
+    _used[slot] = ++_clock;
+    return slot;
+}
+
+Chunk *ChunkCache::lookup(int index) {
+    int slot = slot_of(index);
+    if (slot < 0) {
+        slot = load(index);
+        _loads++;
+    }
+    _used[slot] = ++_clock;
+    _last = slot;
+    return &_chunks[slot];
+}
+
+uint8_t ChunkCache::get(int x, int y) {
+    if (x < 0 || x >= width()) return TILE_WALL;
+    return lookup(x >> CHUNK_SHIFT)->get(x & (CHUNK_WIDTH - 1), y);
+}
+
+bool ChunkCache::solid(int x, int y) {
+    if (x < 0 || x >= width()) return true;
+    return lookup(x >> CHUNK_SHIFT)->solid(x & (CHUNK_WIDTH - 1), y);
+}
+
+bool ChunkCache::set(int x, int y, uint8_t tile) {
+    if (x < 0 || x >= width() || y < 0 || y >= MAP_HEIGHT || tile >= TILE_TYPE_COUNT) return false;
+
+    if (!_edits.set(x, y, tile, get(x, y))) return false;
+
+    int slot = slot_of(x >> CHUNK_SHIFT);
+    if (slot >= 0) _chunks[slot].set(x & (CHUNK_WIDTH - 1), y, tile);
+    _revision++;
+    return true;
+}
+
+void ChunkCache::apply_edits(int index, Chunk &chunk) const {
+    for (size_t i = 0; i < _edits.size(); i++) {
+        TileEdit const &edit = _edits[i];
+        if ((edit.x >> CHUNK_SHIFT) == index) chunk.set(edit.x & (CHUNK_WIDTH - 1), edit.y, edit.tile);
+    }
+}
+
+void ChunkCache::focus(int x, int width, int direction) {
+    if (!_source) return;
+
+    int count = _source->chunk_count();
+    int first = x < 0 ? 0 : x >> CHUNK_SHIFT;
+    int last = (x + width - 1) >> CHUNK_SHIFT;
+    if (last >= count) last = count - 1;
+    for (int i = first; i <= last; i++) lookup(i);
+
+    // decompress the next chunk ahead now, rather than when it scrolls into view
+    int ahead = direction > 0 ? last + 1 : direction < 0 ? first - 1 : -1;
+    if (ahead >= 0 && ahead < count && slot_of(ahead) < 0) {
+        load(ahead);
+        _prefetches++;
+    }
+}
+
+void ChunkCache::report() const {
+    printf("Chunks: %d slots, %u loaded on demand, %u prefetched, %u failed, %u/%u edits\n",
+           _slots, _loads, _prefetches, _failures, (unsigned)_edits.size(), (unsigned)_edits.capacity());
+}
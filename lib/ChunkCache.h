@@ -0,0 +1,81 @@
+#ifndef CHUNKCACHE_H
+#define CHUNKCACHE_H
+
+#include "mbed.h"
+#include "Arena.h"
+#include "Chunk.h"
+#include "ChunkSource.h"
+#include "TileOverlay.h"
+#include "TileWorld.h"
+
+#ifndef MBED_CONF_APP_CHUNK_CACHE_SLOTS
+#define MBED_CONF_APP_CHUNK_CACHE_SLOTS 4
+#endif
+
+#ifndef MBED_CONF_APP_WORLD_EDITS
+#define MBED_CONF_APP_WORLD_EDITS 32
+#endif
+
+/** ChunkCache Class
+@brief Tile access to a world much wider than RAM, decompressing chunks on demand
+
+Keeps a few decompressed chunks of a ChunkSource in slots taken from an
+Arena, so RAM use is the same however wide the world is. get() and solid()
+take world coordinates and work across chunk boundaries; a chunk that isn't
+cached is loaded on the spot, throwing out the least recently used one.
+
+focus() is called once per tick with the viewport: it loads the chunks under
+it and prefetches the next one in the direction of travel, so the loading is
+done in the update and drawing never has to wait for it. Outside the world -
+or in a chunk that failed to load - everything reads as solid wall.
+
+set() changes a tile without touching the source: the change goes in a
+TileOverlay that is laid over each chunk as it loads, so it survives the
+chunk being dropped and remade. Only the edits cost RAM, one TileEdit each.
+
+Example:
+
+@code
+
+static FlashChunkSource source(WORLD, WORLD_SIZE);
+static ChunkCache world;
+
+source.open();                          // once, e.g. in preload()
+world.init(arena(), 4, source, 16);     // in enter()
+world.focus(viewportX, 10, heading);    // every tick
+if (!world.solid(x + 1, y)) x++;
+
+@endcode
+*/
+class ChunkCache : public TileWorld
+{
+public:
+    ChunkCache();
+
+    void init(Arena &arena, int slots, ChunkSource &source, int edits = 0);  // at least 3 slots
+
+    int width() const override;
+    uint8_t get(int x, int y) override;
+    bool solid(int x, int y) override;
+    bool set(int x, int y, uint8_t tile) override;
+    void focus(int x, int width, int direction) override;  // keep [x, x + width) loaded
+    void report() const override;
+
+private:
+    Chunk *lookup(int index);
+    int slot_of(int index) const;
+    int load(int index);
+    void apply_edits(int index, Chunk &chunk) const;
+
+    ChunkSource *_source;
+    Chunk *_chunks;
+    int16_t *_index;    // chunk in each slot, -1 if empty
+    uint32_t *_used;    // last use of each slot, for LRU
+    int _slots;
+    uint32_t _clock;
+    int _last;          // slot of the last lookup, checked first
+    TileOverlay _edits;
+    unsigned _loads, _prefetches, _failures;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#include "ChunkSource.h"
+
+PackedChunkSource::PackedChunkSource() : _count(0) { }
+
+bool PackedChunkSource::read_u32(uint32_t offset, uint32_t &value) {
+    uint8_t bytes[4];
+    if (!read(offset, bytes, 4)) return false;
+    value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    return true;
+}
+
+bool PackedChunkSource::open() {
+    char magic[4];
+    uint32_t count;
+    _count = 0;
+    if (!read(0, magic, 4) || memcmp(magic, "MXW1", 4) != 0) return false;
+    if (!read_u32(4, count) || count == 0 || count > INT16_MAX) return false;
+    _count = count;
+    return true;
+}
+
+int PackedChunkSource::chunk_count() const { return _count; }
+
+bool PackedChunkSource::load(int index, Chunk &chunk) {
+    if (index < 0 || index >= _count) return false;
+
+    uint32_t start, end;
+    if (!read_u32(8 + 4 * index, start) || !read_u32(12 + 4 * index, end)) return false;
+    if (end <= start || end - start > CHUNK_MAX_BYTES) return false;
+
+    uint8_t data[CHUNK_MAX_BYTES];
+    if (!read(start, data, end - start)) return false;
+    return chunk_decode(data, end - start, chunk);
+}
+
+FlashChunkSource::FlashChunkSource(uint8_t const *data, size_t size)
+    : _data(data), _size(size) { }
+
+bool FlashChunkSource::read(uint32_t offset, void *buffer, size_t length) {
+    if (offset > _size || length > _size - offset) return false;
+    memcpy(buffer, _data + offset, length);
+    return true;
+}
+
+BlockDeviceChunkSource::BlockDeviceChunkSource(BlockDevice &device, bd_addr_t start)
+    : _device(device), _start(start) { }
+
+bool BlockDeviceChunkSource::read(uint32_t offset, void *buffer, size_t length) {
+    bd_addr_t addr = _start + offset;
+    bd_size_t unit = _device.get_read_size();
+    uint8_t *out = static_cast<uint8_t *>(buffer);
+
+    if (unit <= 1) return _device.read(out, addr, length) == BD_ERROR_OK;
+    if (unit > CHUNK_BOUNCE_BYTES) return false;
+
+    // read whole units into the bounce buffer and copy out the part we want
+    while (length > 0) {
+        bd_addr_t block = addr - addr % unit;
+        size_t skip = addr - block;
+        size_t n = unit - skip < length ? unit - skip : length;
+        if (_device.read(_bounce, block, unit) != BD_ERROR_OK) return false;
+        memcpy(out, _bounce + skip, n);
+        out += n;
+        addr += n;
+        length -= n;
+    }
+    return true;
+}
+
+FileChunkSource::FileChunkSource(char const *path) : _path(path), _file(nullptr) { }
+
+FileChunkSource::~FileChunkSource() {
+    if (_file) fclose(_file);
+}
+
+bool FileChunkSource::read(uint32_t offset, void *buffer, size_t length) {
+    if (!_file) _file = fopen(_path, "rb");
+    if (!_file || fseek(_file, offset, SEEK_SET) != 0) return false;
+    return fread(buffer, 1, length, _file) == length;
+}
@@ -0,0 +1,103 @@
+#ifndef CHUNKSOURCE_H
+#define CHUNKSOURCE_H
+
+#include "mbed.h"
+#include "blockdevice/BlockDevice.h"
+#include "Chunk.h"
+#include <stdio.h>
+
+/** ChunkSource Class
+@brief Where a ChunkCache gets the chunks of a world from
+
+A world is chunk_count() chunks laid side by side, CHUNK_WIDTH columns each.
+load() fills in one of them and returns false if it could not be read.
+*/
+class ChunkSource
+{
+public:
+    virtual ~ChunkSource() { }
+
+    virtual int chunk_count() const = 0;
+    virtual bool load(int index, Chunk &chunk) = 0;
+};
+
+/** PackedChunkSource Class
+@brief A world stored as a compressed world file
+
+The file (tools/worldpack.py writes it) is, with little-endian numbers:
+
+    "MXW1"                    magic
+    uint32 count              number of chunks
+    uint32 offset[count + 1]  where chunk i starts, from the start of the file
+    ...                       the chunks, compressed as in Chunk.h
+
+so loading a chunk reads two offsets and the chunk's bytes, and nothing else
+of the world has to be in RAM. Subclasses say where the bytes come from;
+open() checks the header before the first load().
+*/
+class PackedChunkSource : public ChunkSource
+{
+public:
+    PackedChunkSource();
+
+    bool open();
+    int chunk_count() const override;
+    bool load(int index, Chunk &chunk) override;
+
+protected:
+    virtual bool read(uint32_t offset, void *buffer, size_t length) = 0;
+
+private:
+    bool read_u32(uint32_t offset, uint32_t &value);
+
+    int _count;
+};
+
+/// World file linked into flash, e.g. one generated by tools/worldpack.py --cpp
+class FlashChunkSource : public PackedChunkSource
+{
+public:
+    FlashChunkSource(uint8_t const *data, size_t size);
+
+protected:
+    bool read(uint32_t offset, void *buffer, size_t length) override;
+
+private:
+    uint8_t const *_data;
+    size_t _size;
+};
+
+// Block devices whose read size is bigger than this can't be streamed from
+#define CHUNK_BOUNCE_BYTES 64
+
+/// World file written to a block device from the given address
+class BlockDeviceChunkSource : public PackedChunkSource
+{
+public:
+    BlockDeviceChunkSource(BlockDevice &device, bd_addr_t start);
+
+protected:
+    bool read(uint32_t offset, void *buffer, size_t length) override;
+
+private:
+    BlockDevice &_device;
+    bd_addr_t _start;
+    uint8_t _bounce[CHUNK_BOUNCE_BYTES];  // for reads not aligned to the device's read size
+};
+
+/// World file on a file system - on the host, a plain file stands in for flash
+class FileChunkSource : public PackedChunkSource
+{
+public:
+    FileChunkSource(char const *path);
+    ~FileChunkSource();
+
+protected:
+    bool read(uint32_t offset, void *buffer, size_t length) override;
+
+private:
+    char const *_path;
+    FILE *_file;
+};
+
+#endif
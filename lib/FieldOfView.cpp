@@ -0,0 +1,114 @@
+#include "FieldOfView.h"
+
+// Slopes are Q16 fixed point, worked out with integer division
+#define SLOPE_ONE (1 << 16)
+
+// Multipliers taking an octant's (dx, dy) to the map, one row per octant
+static const int8_t OCTANTS[8][4] = {
+    { 1,  0,  0,  1 }, { 0,  1,  1,  0 }, { 0, -1,  1,  0 }, { -1,  0,  0,  1 },
+    { -1, 0,  0, -1 }, { 0, -1, -1,  0 }, { 0,  1, -1,  0 }, { 1,  0,  0, -1 },
+};
+
+FieldOfView::FieldOfView()
+    : _radius(0), _x(0), _y(0), _revision(0), _valid(false), _visible(nullptr),
+      _explored(nullptr), _columns(0), _base(0) { }
+
+void FieldOfView::init(Arena &arena, int radius, int explored_columns) {
+    _radius = radius;
+    _visible = arena.array<uint8_t>(2 * radius + 1);
+    _explored = arena.array<uint8_t>(explored_columns);
+    _columns = explored_columns;
+    _base = 0;
+    _valid = false;
+}
+
+bool FieldOfView::visible(int x, int y) const {
+    int i = x - (_x - _radius);
+    if (!_valid || i < 0 || i > 2 * _radius || y < 0 || y >= MAP_HEIGHT) return false;
+    return (_visible[i] >> y) & 1;
+}
+
+bool FieldOfView::explored(int x, int y) const {
+    if (x < _base || x >= _base + _columns || x < 0 || y < 0 || y >= MAP_HEIGHT) return false;
+    return (_explored[x % _columns] >> y) & 1;
+}
+
+void FieldOfView::mark(int x, int y) {
+    if (y < 0 || y >= MAP_HEIGHT) return;
+    int i = x - (_x - _radius);
+    if (i < 0 || i > 2 * _radius) return;
+    _visible[i] |= 1 << y;
+    if (x >= _base && x < _base + _columns && x >= 0) _explored[x % _columns] |= 1 << y;
+}
+
+// Move the explored window to start at base, forgetting columns that leave it
+void FieldOfView::slide(int base) {
+    if (base < 0) base = 0;
+    int shift = base - _base;
+    if (shift >= _columns || -shift >= _columns) {
+        memset(_explored, 0, _columns);
+    } else if (shift > 0) {
+        for (int x = _base; x < base; x++) _explored[x % _columns] = 0;
+    } else {
+        for (int x = base + _columns; x < _base + _columns; x++) _explored[x % _columns] = 0;
+    }
+    _base = base;
+}
+
+// One octant, rows outwards from the player; start and end bound the part of
+// the row still lit, as slopes from 1 (start) down to 0 (end)
+void FieldOfView::cast(TileWorld &world, int row, int32_t start, int32_t end,
+                       int xx, int xy, int yx, int yy) {
+    if (start < end) return;
+
+    int32_t new_start = 0;
+    for (int j = row; j <= _radius; j++) {
+        bool blocked = false;
+        for (int dx = -j; dx <= 0; dx++) {
+            int dy = -j;
+            // slopes of the cell's left and right edges, through its corners
+            int32_t left = (2 * dx - 1) * SLOPE_ONE / (2 * dy + 1);
+            int32_t right = (2 * dx + 1) * SLOPE_ONE / (2 * dy - 1);
+            if (start < right) continue;
+            if (end > left) break;
+
+            int x = _x + dx * xx + dy * xy;
+            int y = _y + dx * yx + dy * yy;
+            if (dx * dx + dy * dy <= _radius * _radius) mark(x, y);
+
+            bool opaque = world.solid(x, y);
+            if (blocked) {
+                if (opaque) {
+                    new_start = right;
+                } else {
+                    blocked = false;
+                    start = new_start;
+                }
+            } else if (opaque && j < _radius) {
+                blocked = true;
+                cast(world, j + 1, start, left, xx, xy, yx, yy);
+                new_start = right;
+            }
+        }
+        if (blocked) break;
+    }
+}
+
+bool FieldOfView::update(TileWorld &world, int x, int y) {
+    if (_valid && x == _x && y == _y && world.revision() == _revision) return false;
+
+    _x = x;
+    _y = y;
+    _revision = world.revision();
+    _valid = true;
+
+    // keep the window of explored columns around the player
+    if (x - _radius < _base || x + _radius >= _base + _columns) slide(x - _columns / 2);
+
+    memset(_visible, 0, 2 * _radius + 1);
+    mark(x, y);
+    for (int i = 0; i < 8; i++) {
+        cast(world, 1, SLOPE_ONE, 0, OCTANTS[i][0], OCTANTS[i][1], OCTANTS[i][2], OCTANTS[i][3]);
+    }
+    return true;
+}
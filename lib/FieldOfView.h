@@ -0,0 +1,52 @@
+#ifndef FIELDOFVIEW_H
+#define FIELDOFVIEW_H
+
+#include "mbed.h"
+#include "Arena.h"
+#include "TileWorld.h"
+
+static_assert(MAP_HEIGHT <= 8, "a column of visibility bits is one byte");
+
+/** FieldOfView Class
+@brief What the player can see from their tile, and what they have seen before
+
+Recursive shadowcasting over the eight octants around the player marks the
+tiles in sight within a radius; solid tiles are seen but block what is
+behind them. Results are bitsets with one byte per column (bit y for row
+y): visible() covers the columns within the radius, explored() a window of
+columns kept around the player in a ring, so RAM is fixed however wide the
+world is and only tiles far behind are forgotten.
+
+update() is called every tick but only recasts when the player has moved to
+another tile or the world's revision() has changed. Slopes are Q16 fixed
+point from integer division, so which tiles are lit never depends on float
+rounding.
+*/
+class FieldOfView
+{
+public:
+    FieldOfView();
+
+    void init(Arena &arena, int radius, int explored_columns);
+    bool update(TileWorld &world, int x, int y);  // true if it was recast
+
+    bool visible(int x, int y) const;
+    bool explored(int x, int y) const;
+
+private:
+    void cast(TileWorld &world, int row, int32_t start, int32_t end, int xx, int xy, int yx, int yy);
+    void mark(int x, int y);
+    void slide(int base);
+
+    int _radius;
+    int _x, _y;                 // where it was last cast from
+    uint32_t _revision;
+    bool _valid;
+
+    uint8_t *_visible;          // columns _x - radius to _x + radius
+    uint8_t *_explored;         // ring of explored columns
+    int _columns;
+    int _base;                  // first column the ring holds
+};
+
+#endif
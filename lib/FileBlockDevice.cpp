@@ -0,0 +1,79 @@
+// Host only: the board has real flash, so the firmware builds none of this
+#if !defined(__MBED__)
+#include "FileBlockDevice.h"
+
+FileBlockDevice::FileBlockDevice(char const *path, bd_size_t size, bd_size_t erase_size, bd_size_t program_size)
+    : _path(path), _size(size), _erase_size(erase_size), _program_size(program_size), _file(nullptr) { }
+
+FileBlockDevice::~FileBlockDevice() {
+    deinit();
+}
+
+int FileBlockDevice::init() {
+    if (_file) return BD_ERROR_OK;
+    if (_size % _erase_size != 0 || _erase_size % _program_size != 0) return BD_ERROR_DEVICE_ERROR;
+
+    _file = fopen(_path, "r+b");
+    if (!_file) _file = fopen(_path, "w+b");
+    if (!_file) return BD_ERROR_DEVICE_ERROR;
+
+    // a new or short file is blank flash past its end
+    fseek(_file, 0, SEEK_END);
+    long length = ftell(_file);
+    for (long i = length < 0 ? 0 : length; i < (long)_size; i++) fputc(FILE_BD_ERASED, _file);
+    return fflush(_file) == 0 ? BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+}
+
+int FileBlockDevice::deinit() {
+    if (_file) fclose(_file);
+    _file = nullptr;
+    return BD_ERROR_OK;
+}
+
+bool FileBlockDevice::fits(bd_addr_t addr, bd_size_t size, bd_size_t unit) const {
+    return _file && addr % unit == 0 && size % unit == 0 && addr <= _size && size <= _size - addr;
+}
+
+int FileBlockDevice::read(void *buffer, bd_addr_t addr, bd_size_t size) {
+    if (!fits(addr, size, 1) || fseek(_file, addr, SEEK_SET) != 0) return BD_ERROR_DEVICE_ERROR;
+    return fread(buffer, 1, size, _file) == size ? BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+}
+
+// A unit at a time: read what is there and AND the new bits in, as flash would
+int FileBlockDevice::program(const void *buffer, bd_addr_t addr, bd_size_t size) {
+    if (!fits(addr, size, _program_size)) return BD_ERROR_DEVICE_ERROR;
+    uint8_t const *in = static_cast<uint8_t const *>(buffer);
+    uint8_t unit[64];
+    if (_program_size > sizeof(unit)) return BD_ERROR_DEVICE_ERROR;
+
+    for (bd_size_t done = 0; done < size; done += _program_size) {
+        if (read(unit, addr + done, _program_size) != BD_ERROR_OK) return BD_ERROR_DEVICE_ERROR;
+        for (bd_size_t i = 0; i < _program_size; i++) unit[i] &= in[done + i];
+        if (fseek(_file, addr + done, SEEK_SET) != 0 || fwrite(unit, 1, _program_size, _file) != _program_size) {
+            return BD_ERROR_DEVICE_ERROR;
+        }
+    }
+    return fflush(_file) == 0 ? BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+}
+
+int FileBlockDevice::erase(bd_addr_t addr, bd_size_t size) {
+    if (!fits(addr, size, _erase_size) || fseek(_file, addr, SEEK_SET) != 0) return BD_ERROR_DEVICE_ERROR;
+    for (bd_size_t i = 0; i < size; i++) fputc(FILE_BD_ERASED, _file);
+    return fflush(_file) == 0 ? BD_ERROR_OK : BD_ERROR_DEVICE_ERROR;
+}
+
+bd_size_t FileBlockDevice::get_read_size() const { return 1; }
+
+bd_size_t FileBlockDevice::get_program_size() const { return _program_size; }
+
+bd_size_t FileBlockDevice::get_erase_size() const { return _erase_size; }
+
+bd_size_t FileBlockDevice::get_erase_size(bd_addr_t) const { return _erase_size; }  // the blocks are all one size
+
+int FileBlockDevice::get_erase_value() const { return FILE_BD_ERASED; }
+
+bd_size_t FileBlockDevice::size() const { return _size; }
+
+const char *FileBlockDevice::get_type() const { return "FILE"; }
+
+#endif
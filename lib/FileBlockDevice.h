@@ -0,0 +1,60 @@
+#ifndef FILEBLOCKDEVICE_H
+#define FILEBLOCKDEVICE_H
+
+#include "mbed.h"
+#include "blockdevice/BlockDevice.h"
+#include <stdio.h>
+
+// Flash reads as this once erased
+#define FILE_BD_ERASED 0xFF
+
+/** FileBlockDevice Class
+@brief A plain file standing in for flash on the host
+
+Behaves like the NOR flash it replaces, so code that gets it wrong fails on
+the host too: programs and erases have to be whole units and aligned, an
+erase sets a block to 0xFF, and programming can only clear bits, so writing
+over data without erasing it first leaves the two ANDed together. The file
+is made, blank, by init() if it doesn't exist or is too short. It is only
+built for the host; with __MBED__ defined the source compiles to nothing.
+
+Example:
+
+@code
+
+FileBlockDevice flash("maps.bin", 64 * 1024, 4096);
+ProfilingBlockDevice wear(&flash);
+TDBStore store(&wear);
+MapStore maps(store, wear);
+maps.init();
+
+@endcode
+*/
+class FileBlockDevice : public BlockDevice
+{
+public:
+    FileBlockDevice(char const *path, bd_size_t size, bd_size_t erase_size = 4096, bd_size_t program_size = 8);
+    ~FileBlockDevice();
+
+    int init() override;
+    int deinit() override;
+    int read(void *buffer, bd_addr_t addr, bd_size_t size) override;
+    int program(const void *buffer, bd_addr_t addr, bd_size_t size) override;
+    int erase(bd_addr_t addr, bd_size_t size) override;
+    bd_size_t get_read_size() const override;
+    bd_size_t get_program_size() const override;
+    bd_size_t get_erase_size() const override;
+    bd_size_t get_erase_size(bd_addr_t addr) const override;
+    int get_erase_value() const override;
+    bd_size_t size() const override;
+    const char *get_type() const override;
+
+private:
+    bool fits(bd_addr_t addr, bd_size_t size, bd_size_t unit) const;
+
+    char const *_path;
+    bd_size_t _size, _erase_size, _program_size;
+    FILE *_file;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "FlashLevel.h"
+
+void FlashLevel::init(Arena &arena, int edits) {
+    _overlay.init(arena, edits);
+    _edited = arena.array<uint32_t>(MAP_HEIGHT * _words);
+}
+
+int FlashLevel::width() const { return _width; }
+
+bool FlashLevel::in_bounds(int x, int y) const {
+    return x >= 0 && x < _width && y >= 0 && y < MAP_HEIGHT;
+}
+
+bool FlashLevel::edited(int x, int y) const {
+    return _edited && (_edited[y * _words + x / 32] >> (x % 32)) & 1;
+}
+
+uint8_t FlashLevel::get(int x, int y) {
+    if (!in_bounds(x, y)) return TILE_WALL;
+    if (edited(x, y)) return _overlay[_overlay.find(x, y)].tile;
+
+    uint8_t pair = _cells[y * (_width / 2) + x / 2];
+    return (x & 1) ? pair >> 4 : pair & 0x0F;
+}
+
+bool FlashLevel::solid(int x, int y) {
+    if (!in_bounds(x, y)) return true;
+    if (edited(x, y)) return TILE_PROPS[_overlay[_overlay.find(x, y)].tile].flags & TILE_SOLID;
+    return (_solid[y * _words + x / 32] >> (x % 32)) & 1;
+}
+
+bool FlashLevel::set(int x, int y, uint8_t tile) {
+    if (!in_bounds(x, y) || tile >= TILE_TYPE_COUNT || !_edited) return false;
+    if (!_overlay.set(x, y, tile, get(x, y))) return false;
+    uint32_t bit = (uint32_t)1 << (x % 32);
+    if (_overlay.find(x, y) >= 0) _edited[y * _words + x / 32] |= bit;
+    else _edited[y * _words + x / 32] &= ~bit;
+    _revision++;
+    return true;
+}
+
+void FlashLevel::report() const {
+    printf("Level: %d columns in flash, %u/%u tiles changed\n",
+           _width, (unsigned)_overlay.size(), (unsigned)_overlay.capacity());
+}
@@ -0,0 +1,95 @@
+#ifndef FLASHLEVEL_H
+#define FLASHLEVEL_H
+
+#include "mbed.h"
+#include "Arena.h"
+#include "TileMap.h"
+#include "TileOverlay.h"
+#include "TileWorld.h"
+
+/// A level packed at compile time: 4-bit tiles and a solidity bitset, in flash
+template <int WIDTH_TILES>
+struct PackedLevel {
+    static_assert(WIDTH_TILES % 2 == 0, "two tiles per byte");
+
+    uint8_t cells[MAP_HEIGHT][WIDTH_TILES / 2];             // even columns in the low nibble
+    uint32_t solid[MAP_HEIGHT][(WIDTH_TILES + 31) / 32];
+    bool valid;                                             // every character was a tile
+};
+
+/// Pack MAP_HEIGHT rows of level art (TILE_CHARS) - use it to initialise a constexpr level
+template <int WIDTH_TILES>
+constexpr PackedLevel<WIDTH_TILES> pack_level(char const (&art)[MAP_HEIGHT][WIDTH_TILES + 1]) {
+    PackedLevel<WIDTH_TILES> level = {};
+    level.valid = true;
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < WIDTH_TILES; x++) {
+            uint8_t tile = tile_from_char(art[y][x]);
+            if (tile >= TILE_TYPE_COUNT) {
+                level.valid = false;  // a short row ends in '\0'
+                continue;
+            }
+            level.cells[y][x / 2] |= tile << 4 * (x & 1);
+            if (TILE_PROPS[tile].flags & TILE_SOLID) level.solid[y][x / 32] |= (uint32_t)1 << (x % 32);
+        }
+    }
+    return level;
+}
+
+/** FlashLevel Class
+@brief A TileWorld read in place from a PackedLevel, with changes in a RAM overlay
+
+Levels are drawn as art in the source and packed by the compiler, so they sit
+in flash ready to read: entering a level copies nothing. Tiles are read
+straight from flash unless set() has changed them; changes go in a small
+TileOverlay, plus one bit per tile saying which have an entry there, so
+reading an unchanged tile never searches the overlay.
+
+Example:
+
+@code
+
+extern const PackedLevel<16> LEVEL;      // in a header, so LEVEL is shared
+
+constexpr char LEVEL_ART[MAP_HEIGHT][17] = {
+    "################",
+    "#..............#",
+    ...
+};
+constexpr PackedLevel<16> LEVEL = pack_level<16>(LEVEL_ART);
+static_assert(LEVEL.valid, "level art has a short row or an unknown tile");
+
+FlashLevel level(LEVEL);
+level.init(arena, 16);                   // room for 16 changed tiles
+
+@endcode
+*/
+class FlashLevel : public TileWorld
+{
+public:
+    template <int WIDTH_TILES>
+    FlashLevel(PackedLevel<WIDTH_TILES> const &level)
+        : _cells(&level.cells[0][0]), _solid(&level.solid[0][0]), _width(WIDTH_TILES),
+          _words((WIDTH_TILES + 31) / 32), _edited(nullptr) { }
+
+    void init(Arena &arena, int edits);  // forgets earlier changes
+
+    int width() const override;
+    uint8_t get(int x, int y) override;
+    bool solid(int x, int y) override;
+    bool set(int x, int y, uint8_t tile) override;
+    void report() const override;
+
+private:
+    bool in_bounds(int x, int y) const;
+    bool edited(int x, int y) const;
+
+    uint8_t const *_cells;
+    uint32_t const *_solid;
+    int _width;
+    int _words;             // bitset words per row
+    TileOverlay _overlay;
+    uint32_t *_edited;      // same layout as _solid: tiles with an overlay entry
+};
+
+#endif
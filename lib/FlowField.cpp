@@ -0,0 +1,261 @@
+#include "FlowField.h"
+
+#define COLUMN_BITS ((1u << MAP_HEIGHT) - 1)
+
+FlowField::FlowField()
+    : _columns(0), _climb(0), _left(0), _solid(nullptr), _east(nullptr), _west(nullptr),
+      _queued(nullptr), _dist(nullptr), _queue(nullptr), _head(0), _count(0), _goals(0) { }
+
+void FlowField::init(Arena &arena, int columns, int climb) {
+    _columns = columns;
+    _climb = climb;
+    _left = 0;
+    _solid = arena.array<uint8_t>(columns);
+    _east = arena.array<uint8_t>(columns);
+    _west = arena.array<uint8_t>(columns);
+    _queued = arena.array<uint8_t>(columns);
+    _dist = arena.array<uint8_t>(columns * MAP_HEIGHT);
+    _queue = arena.array<uint16_t>(columns * MAP_HEIGHT);
+    memset(_dist, FLOW_UNREACHED, columns * MAP_HEIGHT);
+    _goals = 0;
+}
+
+void FlowField::begin(TileWorld &world, int left) {
+    _left = left;
+    for (int i = 0; i < _columns; i++) {
+        uint8_t bits = 0;
+        for (int y = 0; y < MAP_HEIGHT; y++) {
+            if (world.solid(left + i, y)) bits |= 1 << y;
+        }
+        _solid[i] = bits;
+    }
+    memset(_dist, FLOW_UNREACHED, _columns * MAP_HEIGHT);
+    memset(_east, 0, _columns);
+    memset(_west, 0, _columns);
+    _goals = 0;
+}
+
+void FlowField::clear() { _goals = 0; }
+
+bool FlowField::goal(int x, int y) {
+    if (!covers(x) || y < 0 || y >= MAP_HEIGHT || _goals == FLOW_GOALS) return false;
+    _goal_x[_goals] = x;
+    _goal_y[_goals] = y;
+    _goals++;
+    return true;
+}
+
+int FlowField::left() const { return _left; }
+
+bool FlowField::covers(int x) const { return x >= _left && x < _left + _columns; }
+
+// Open tiles with solid under them; the row below the map counts as solid
+uint8_t FlowField::floor(int column) const {
+    uint8_t solid = _solid[column];
+    uint8_t below = (solid >> 1) | (1 << (MAP_HEIGHT - 1));
+    return ~solid & below & COLUMN_BITS;
+}
+
+bool FlowField::standing(int x, int y) const {
+    if (!covers(x) || y < 0 || y >= MAP_HEIGHT) return false;
+    return (floor(x - _left) >> y) & 1;
+}
+
+int FlowField::land(int x, int y) const {
+    if (!covers(x) || y < 0 || y >= MAP_HEIGHT) return -1;
+    uint8_t solid = _solid[x - _left];
+    if ((solid >> y) & 1) return -1;
+    while (y + 1 < MAP_HEIGHT && !((solid >> (y + 1)) & 1)) y++;
+    return y;
+}
+
+// Row a walker standing in (column, row) ends up in after a step, -1 if it can't go
+int FlowField::next(int column, int row, int direction) const {
+    int to = column + direction;
+    if (to < 0 || to >= _columns) return -1;
+    uint8_t here = _solid[column], there = _solid[to];
+
+    // open: walk across and fall to the ground
+    if (!((there >> row) & 1)) {
+        while (row + 1 < MAP_HEIGHT && !((there >> (row + 1)) & 1)) row++;
+        return row;
+    }
+    // a wall: climb it if it is low enough and nothing is overhead
+    for (int up = 1; up <= _climb && row - up >= 0; up++) {
+        if ((here >> (row - up)) & 1) return -1;
+        if (!((there >> (row - up)) & 1)) return row - up;
+    }
+    return -1;
+}
+
+int FlowField::next_row(int x, int y, int direction) const {
+    if (!standing(x, y)) return -1;
+    return next(x - _left, y, direction);
+}
+
+int FlowField::distance(int x, int y) const {
+    if (!covers(x) || y < 0 || y >= MAP_HEIGHT) return FLOW_UNREACHED;
+    return _dist[(x - _left) * MAP_HEIGHT + y];
+}
+
+int FlowField::direction(int x, int y) const {
+    if (!covers(x) || y < 0 || y >= MAP_HEIGHT) return 0;
+    int i = x - _left;
+    if ((_east[i] >> y) & 1) return 1;
+    if ((_west[i] >> y) & 1) return -1;
+    return 0;
+}
+
+bool FlowField::reachable(int x, int y) const { return distance(x, y) != FLOW_UNREACHED; }
+
+void FlowField::route(int cell, int direction) {
+    int column = cell / MAP_HEIGHT;
+    uint8_t bit = 1 << (cell % MAP_HEIGHT);
+    _east[column] &= ~bit;
+    _west[column] &= ~bit;
+    if (direction > 0) _east[column] |= bit;
+    if (direction < 0) _west[column] |= bit;
+}
+
+void FlowField::push(int cell) {
+    int column = cell / MAP_HEIGHT;
+    uint8_t bit = 1 << (cell % MAP_HEIGHT);
+    if (_queued[column] & bit) return;  // so never more than one slot per tile
+    _queued[column] |= bit;
+    _queue[(_head + _count) % (_columns * MAP_HEIGHT)] = cell;
+    _count++;
+}
+
+int FlowField::pop() {
+    int cell = _queue[_head];
+    _head = (_head + 1) % (_columns * MAP_HEIGHT);
+    _count--;
+    _queued[cell / MAP_HEIGHT] &= ~(1 << (cell % MAP_HEIGHT));
+    return cell;
+}
+
+// Pass distances back along the steps that lead into each queued tile. A tile
+// is queued again whenever it gets closer, so starting from a mix of distances
+// (after a repair) still settles on the shortest.
+void FlowField::flood() {
+    while (_count > 0) {
+        int cell = pop();
+        int d = _dist[cell];
+        if (d + 1 >= FLOW_UNREACHED) continue;
+        int x = cell / MAP_HEIGHT, y = cell % MAP_HEIGHT;
+
+        for (int direction = -1; direction <= 1; direction += 2) {
+            int from = x - direction;  // walkers there step this way to get here
+            if (from < 0 || from >= _columns) continue;
+            uint8_t ground = floor(from);
+            for (int row = 0; row < MAP_HEIGHT; row++) {
+                if (!((ground >> row) & 1) || next(from, row, direction) != y) continue;
+                int before = from * MAP_HEIGHT + row;
+                if (d + 1 >= _dist[before]) continue;
+                _dist[before] = d + 1;
+                route(before, direction);
+                push(before);
+            }
+        }
+    }
+}
+
+void FlowField::build() {
+    memset(_dist, FLOW_UNREACHED, _columns * MAP_HEIGHT);
+    memset(_east, 0, _columns);
+    memset(_west, 0, _columns);
+    memset(_queued, 0, _columns);
+    _head = 0;
+    _count = 0;
+
+    for (int g = 0; g < _goals; g++) {
+        int row = land(_goal_x[g], _goal_y[g]);
+        if (row < 0) continue;
+        int cell = (_goal_x[g] - _left) * MAP_HEIGHT + row;
+        _dist[cell] = 0;
+        push(cell);
+    }
+    flood();
+}
+
+void FlowField::forget(int cell) {
+    if (_dist[cell] == FLOW_UNREACHED) return;
+    _dist[cell] = FLOW_UNREACHED;
+    route(cell, 0);
+    push(cell);
+}
+
+void FlowField::repair(TileWorld &world, int x) {
+    int i = x - _left;
+    if (i < 0 || i >= _columns) return;
+
+    uint8_t bits = 0;
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        if (world.solid(x, y)) bits |= 1 << y;
+    }
+    _solid[i] = bits;
+
+    // a goal beside the change may now come to rest somewhere else
+    for (int g = 0; g < _goals; g++) {
+        if (_goal_x[g] >= x - 1 && _goal_x[g] <= x + 1) {
+            build();
+            return;
+        }
+    }
+
+    // Steps out of the changed column and its neighbours are all that can be
+    // different, so forget the floor there and then every tile routed through
+    // it. The queue is empty between calls, so the tiles forgotten stay listed
+    // in it from slot 0 once it has been worked through.
+    _head = 0;
+    _count = 0;
+    for (int column = i - 1; column <= i + 1; column++) {
+        if (column < 0 || column >= _columns) continue;
+        for (int row = 0; row < MAP_HEIGHT; row++) {
+            int cell = column * MAP_HEIGHT + row;
+            _dist[cell] = FLOW_UNREACHED;
+            route(cell, 0);
+            push(cell);
+        }
+    }
+    int forgotten = 0;
+    while (_count > 0) {
+        int cell = pop();
+        forgotten++;
+        int column = cell / MAP_HEIGHT, y = cell % MAP_HEIGHT;
+        for (int direction = -1; direction <= 1; direction += 2) {
+            int from = column - direction;
+            if (from < 0 || from >= _columns) continue;
+            uint8_t routed = (direction > 0 ? _east[from] : _west[from]) & floor(from);
+            for (int row = 0; row < MAP_HEIGHT; row++) {
+                if (((routed >> row) & 1) && next(from, row, direction) == y) {
+                    forget(from * MAP_HEIGHT + row);
+                }
+            }
+        }
+    }
+
+    // take each forgotten tile's best step to a tile that still has a distance,
+    // then flood from those that found one
+    for (int k = 0; k < forgotten; k++) {
+        int cell = _queue[k];
+        int column = cell / MAP_HEIGHT, y = cell % MAP_HEIGHT;
+        if (!((floor(column) >> y) & 1)) continue;
+        for (int direction = -1; direction <= 1; direction += 2) {
+            int row = next(column, y, direction);
+            if (row < 0) continue;
+            int d = _dist[(column + direction) * MAP_HEIGHT + row] + 1;
+            if (d < _dist[cell]) {
+                _dist[cell] = d;
+                route(cell, direction);
+            }
+        }
+    }
+    _head = 0;
+    _count = 0;
+    for (int k = 0; k < forgotten; k++) {
+        int cell = _queue[k];  // push() only writes slots already read
+        if (_dist[cell] != FLOW_UNREACHED) push(cell);
+    }
+    flood();
+}
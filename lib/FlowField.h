@@ -0,0 +1,93 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "mbed.h"
+#include "Arena.h"
+#include "TileWorld.h"
+
+static_assert(MAP_HEIGHT <= 8, "a column of flow bits is one byte");
+
+// distance() of a tile with no way to a goal
+#define FLOW_UNREACHED 0xFF
+// Most goals one field floods from, e.g. the floor beside every habitat in view
+#define FLOW_GOALS 8
+
+/** FlowField Class
+@brief Which way to walk from every floor tile in a window to the nearest goal
+
+Walkers stand on open tiles with solid ground under them. From there a step
+goes one column left or right: onto an open tile, falling to the ground
+below it, or up a wall of at most `climb` tiles if there is headroom. The
+field is a breadth-first flood backwards along those steps from the goals,
+over a window of columns read from the TileWorld once, so it works the same
+on endless worlds. It costs one byte per tile plus a few bytes per column.
+
+Every floor tile ends up with its distance and the direction of its first
+step, so any number of walkers share one field and each only does an O(1)
+direction() lookup a tile. When a tile changes, repair() forgets the floor
+around it and whatever was routed through there, then refloods just that
+part; moving the goal calls for clear(), goal() and build() again.
+
+Example:
+
+@code
+
+FlowField chase;
+chase.init(arena(), 32, 1);
+chase.begin(world, 0);
+chase.goal(player_x, player_y);
+chase.build();
+...
+int dir = chase.direction(rover_x, rover_y);  // -1, 0 or 1
+
+@endcode
+*/
+class FlowField
+{
+public:
+    FlowField();
+
+    void init(Arena &arena, int columns, int climb);
+
+    void begin(TileWorld &world, int left);  // window from column left, no goals yet
+    void clear();                            // drop the goals
+    bool goal(int x, int y);                 // lands where something at (x, y) would come to rest
+    void build();                            // flood from the goals
+    void repair(TileWorld &world, int x);    // a tile in column x has changed
+
+    int left() const;
+    bool covers(int x) const;
+    bool standing(int x, int y) const;       // open, with solid ground under it
+    int land(int x, int y) const;            // row a fall from (x, y) stops in, -1 if solid
+    int next_row(int x, int y, int direction) const;  // after one step that way, -1 if blocked
+
+    int distance(int x, int y) const;        // steps to the nearest goal
+    int direction(int x, int y) const;       // -1, 0 or 1; 0 at a goal or with no way there
+    bool reachable(int x, int y) const;
+
+private:
+    uint8_t floor(int column) const;
+    int next(int column, int row, int direction) const;
+    void route(int cell, int direction);
+    void forget(int cell);
+    void push(int cell);
+    int pop();
+    void flood();
+
+    int _columns;
+    int _climb;
+    int _left;                  // first column of the window
+
+    uint8_t *_solid;            // per column: bit y is row y
+    uint8_t *_east, *_west;     // per column: the first step from row y is that way
+    uint8_t *_queued;           // per column: row y is waiting in the queue
+    uint8_t *_dist;             // per tile, column-major
+    uint16_t *_queue;           // ring of tiles to expand, one slot per tile
+    int _head, _count;
+
+    int32_t _goal_x[FLOW_GOALS];
+    int8_t _goal_y[FLOW_GOALS];
+    int _goals;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#include "FrameGovernor.h"
+#include "Log.h"
+
+// Each frame moves the average 1/8 of the way to the new time
+#define AVERAGE_SHIFT 3
+
+// Over budget for this many frames drops a feature, and at most this often
+#define DEGRADE_FRAMES 4
+// Under RESTORE_PERCENT of the budget for this many frames restores one
+#define RESTORE_FRAMES 30
+#define RESTORE_PERCENT 60
+
+FrameGovernor::FrameGovernor() : _budget(0) {
+    reset();
+}
+
+void FrameGovernor::set_budget(uint32_t us) {
+    _budget = us;
+    _hold = 0;
+}
+
+void FrameGovernor::reset() {
+    _average = 0;
+    _level = 0;
+    _hold = 0;
+}
+
+void FrameGovernor::frame(uint32_t us) {
+    if (_budget == 0) return;  // governor off
+
+    if (_average == 0) {
+        _average = us;
+    } else {
+        _average = _average + ((int32_t)(us - _average) >> AVERAGE_SHIFT);
+    }
+
+    if (_average > _budget) {
+        _hold = _hold > 0 ? _hold + 1 : 1;
+        if (_hold >= DEGRADE_FRAMES && _level < QUALITY_LEVELS) change_level(_level + 1);
+    } else if (_average < _budget * RESTORE_PERCENT / 100) {
+        _hold = _hold < 0 ? _hold - 1 : -1;
+        if (-_hold >= RESTORE_FRAMES && _level > 0) change_level(_level - 1);
+    } else {
+        _hold = 0;
+    }
+}
+
+void FrameGovernor::change_level(int level) {
+    if (level > _level) {
+        LOG_WARN(LOG_GOVERNOR_DROP, _average, _budget, level);
+    } else {
+        LOG_INFO(LOG_GOVERNOR_RESTORE, _average, _budget, level);
+    }
+    _level = level;
+    _hold = 0;
+}
+
+bool FrameGovernor::enabled(QualityFeature feature) const {
+    return feature >= _level;
+}
+
+int FrameGovernor::level() const { return _level; }
+
+uint32_t FrameGovernor::average() const { return _average; }
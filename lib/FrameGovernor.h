@@ -0,0 +1,51 @@
+#ifndef FRAMEGOVERNOR_H
+#define FRAMEGOVERNOR_H
+
+#include "mbed.h"
+
+/// Optional work a scene can drop under load, in the order it is given up
+enum QualityFeature {
+    QUALITY_BACKGROUND,  // background animation
+    QUALITY_PARTICLES,   // particle effects
+    QUALITY_HUD,         // HUD text re-formatted every frame rather than every few
+    QUALITY_FULL_FLUSH,  // whole frame sent to the display rather than changed columns only
+    QUALITY_LEVELS
+};
+
+// Scenes that drop QUALITY_HUD re-format their HUD this often
+#define HUD_SLOW_FRAMES 5
+
+/** FrameGovernor Class
+@brief Trades optional frame work for keeping the game on its tick
+
+frame() is given the time each drawn frame took on the game thread (update,
+draw and the hand-off to the display). A smoothed average of that is compared
+with the budget, a percentage of the scene's tick. While the average runs over
+budget one more QualityFeature is dropped every few frames; once it has stayed
+well under budget for a couple of seconds the last one dropped is restored.
+Every change is logged with the average and budget that caused it.
+
+The level is the number of features currently dropped, so 0 is full quality.
+*/
+class FrameGovernor
+{
+public:
+    FrameGovernor();
+
+    void set_budget(uint32_t us);      // e.g. when the tick changes
+    void reset();                      // back to full quality, e.g. for a new scene
+    void frame(uint32_t us);           // a frame took us to produce
+    bool enabled(QualityFeature feature) const;
+    int level() const;
+    uint32_t average() const;          // smoothed frame time in us
+
+private:
+    void change_level(int level);
+
+    uint32_t _budget;
+    uint32_t _average;
+    int _level;
+    int _hold;   // frames the average has been on the same side of the budget
+};
+
+#endif
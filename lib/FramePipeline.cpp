@@ -0,0 +1,110 @@
+#include "FramePipeline.h"
+#include "Profiler.h"
+#include "hal/us_ticker_api.h"
+
+#define FLAG_FREE(i)  (0x01u << (i))
+#define FLAG_READY(i) (0x04u << (i))
+
+#if DEVICE_SPI_ASYNCH
+#define DISPLAY_PRIORITY osPriorityAboveNormal  // sleeps while the transfer runs
+#else
+#define DISPLAY_PRIORITY osPriorityBelowNormal  // polled SPI runs while the game thread sleeps
+#endif
+
+static void atomic_max(volatile uint32_t *max, uint32_t value) {
+    uint32_t seen = core_util_atomic_load_u32(max);
+    while (value > seen && !core_util_atomic_cas_u32(max, &seen, value)) { }
+}
+
+FramePipeline::FramePipeline(N5110 &lcd, InputSource *input)
+    : _lcd(lcd), _input(input), _thread(DISPLAY_PRIORITY, 1024, nullptr, "display"),
+      _write(0), _presented(0), _flushed(0) {
+    reset_stats();
+}
+
+void FramePipeline::start() {
+    _flags.set(FLAG_FREE(0) | FLAG_FREE(1));
+    _thread.start(callback(this, &FramePipeline::display_main));
+    _lcd.attachPresenter(callback(this, &FramePipeline::present));
+}
+
+void FramePipeline::present(unsigned char const *frame) {
+    // wait for the display thread to finish with this buffer
+    if (!(_flags.get() & FLAG_FREE(_write))) {
+        uint32_t start = us_ticker_read();
+        _flags.wait_any(FLAG_FREE(_write));
+        uint32_t waited = us_ticker_read() - start;
+        _stats.stalls++;
+        if (waited > _stats.wait_max) _stats.wait_max = waited;
+    } else {
+        _flags.clear(FLAG_FREE(_write));
+    }
+
+    memcpy(_frames[_write], frame, FRAME_BYTES);
+    _input_us[_write] = _input ? _input->sampled_at() : us_ticker_read();
+
+    uint32_t depth = core_util_atomic_incr_u32(&_presented, 1) - core_util_atomic_load_u32(&_flushed);
+    if (depth > _stats.depth_max) _stats.depth_max = depth;
+
+    _flags.set(FLAG_READY(_write));
+    _write ^= 1;
+}
+
+void FramePipeline::display_main() {
+    int read = 0;
+    while (true) {
+        _flags.wait_any(FLAG_READY(read));
+
+        uint32_t start = us_ticker_read();
+        {
+            PROFILE_ZONE(ZONE_FLUSH);
+            _lcd.sendFrame(_frames[read]);
+        }
+        uint32_t end = us_ticker_read();
+
+        uint32_t flush = end - start;
+        uint32_t latency = end - _input_us[read];
+        core_util_atomic_incr_u32(&_flush_total, flush);
+        core_util_atomic_incr_u32(&_latency_total, latency);
+        atomic_max(&_flush_max, flush);
+        atomic_max(&_latency_max, latency);
+        core_util_atomic_incr_u32(&_flushes, 1);
+
+        core_util_atomic_incr_u32(&_flushed, 1);
+        _flags.set(FLAG_FREE(read));
+        read ^= 1;
+    }
+}
+
+PipelineStats FramePipeline::get_stats() const {
+    PipelineStats stats = _stats;
+    // frames first: the totals are added to before it, so never cover fewer frames
+    stats.frames = core_util_atomic_load_u32(&_flushes);
+    stats.flush_max = core_util_atomic_load_u32(&_flush_max);
+    stats.latency_max = core_util_atomic_load_u32(&_latency_max);
+    if (stats.frames) {
+        stats.flush_avg = core_util_atomic_load_u32(&_flush_total) / stats.frames;
+        stats.latency_avg = core_util_atomic_load_u32(&_latency_total) / stats.frames;
+    }
+    return stats;
+}
+
+void FramePipeline::reset_stats() {
+    memset(&_stats, 0, sizeof(_stats));
+    core_util_atomic_store_u32(&_flushes, 0);
+    core_util_atomic_store_u32(&_flush_total, 0);
+    core_util_atomic_store_u32(&_flush_max, 0);
+    core_util_atomic_store_u32(&_latency_total, 0);
+    core_util_atomic_store_u32(&_latency_max, 0);
+}
+
+void FramePipeline::print_stats() const {
+    PipelineStats s = get_stats();
+    printf("Pipeline: %u frames, depth %u, %u stalls (max %u us), flush avg %u max %u us, "
+           "latency avg %u max %u us",
+           (unsigned)s.frames, (unsigned)s.depth_max, (unsigned)s.stalls, (unsigned)s.wait_max,
+           (unsigned)s.flush_avg, (unsigned)s.flush_max,
+           (unsigned)s.latency_avg, (unsigned)s.latency_max);
+    if (_input) printf(", input read max %u us", (unsigned)_input->sample_time_max());
+    printf("\n");
+}
@@ -0,0 +1,69 @@
+#ifndef FRAMEPIPELINE_H
+#define FRAMEPIPELINE_H
+
+#include "mbed.h"
+#include "N5110.h"
+#include "InputSource.h"
+
+/// Timings gathered by a FramePipeline, all in microseconds
+struct PipelineStats {
+    uint32_t frames;        // frames sent to the display
+    uint32_t depth_max;     // most frames in flight at once (1 = no overlap, 2 = full)
+    uint32_t stalls;        // presents that had to wait for a free buffer
+    uint32_t wait_max;      // longest such wait
+    uint32_t flush_avg;     // SPI transfer time
+    uint32_t flush_max;
+    uint32_t latency_avg;   // input snapshot taken -> frame on the glass
+    uint32_t latency_max;
+};
+
+/** FramePipeline Class
+@brief Double-buffered hand-off of finished frames to a display thread
+
+Once started, lcd.refresh() no longer blocks on SPI. The frame is copied into
+one of two buffers and the display thread sends it while the game thread goes
+on to draw the next one. EventFlags carry the hand-off: a FREE bit per buffer
+that the game thread waits on and a READY bit per buffer that the display thread
+waits on. If both buffers are still in flight the game thread waits (a stall),
+so the pipeline is never more than two frames deep.
+
+Latency is measured from the time-stamp of the input snapshot the frame was
+built from (see InputSource::sampled_at) to the end of its SPI transfer.
+The display thread's timings are only touched through core_util_atomic_*, as
+the game thread reads and resets them while frames are in flight.
+*/
+class FramePipeline
+{
+public:
+    FramePipeline(N5110 &lcd, InputSource *input = nullptr);
+
+    void start();                   // start the display thread and take over lcd.refresh()
+
+    PipelineStats get_stats() const;
+    void reset_stats();
+    void print_stats() const;
+
+private:
+    void present(unsigned char const *frame);  // game thread, called from lcd.refresh()
+    void display_main();                       // display thread
+
+    N5110 &_lcd;
+    InputSource *_input;
+    Thread _thread;
+    EventFlags _flags;
+
+    unsigned char _frames[2][FRAME_BYTES];
+    uint32_t _input_us[2];      // input time-stamp of the frame in each buffer
+    int _write;                 // buffer the game thread fills next
+    volatile uint32_t _presented;
+    volatile uint32_t _flushed;
+
+    PipelineStats _stats;             // game thread: depth and stalls
+    volatile uint32_t _flushes;       // display thread, atomic
+    volatile uint32_t _flush_total;
+    volatile uint32_t _flush_max;
+    volatile uint32_t _latency_total;
+    volatile uint32_t _latency_max;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "GameLoop.h"
+
+GameLoop::GameLoop(Kernel::Clock::duration tick, int max_catch_up)
+    : _tick(tick), _max_catch_up(max_catch_up < 1 ? 1 : max_catch_up) {
+    reset_stats();
+}
+
+void GameLoop::start() {
+    _next = Kernel::Clock::now();
+    reset_stats();
+}
+
+void GameLoop::resync() { _next = Kernel::Clock::now(); }
+
+int GameLoop::wait() {
+    Kernel::Clock::time_point now = Kernel::Clock::now();
+    if (now < _next) {
+        ThisThread::sleep_until(_next);
+        now = Kernel::Clock::now();
+    } else if (now > _next) {
+        _stats.overruns++;  // the frame's work already used up this deadline
+    }
+
+    // how far past the deadline we woke - scheduling jitter, or the overrun
+    uint32_t late = (uint32_t)(now - _next).count();
+    _stats.late_total += late;
+    if (late > _stats.late_max) _stats.late_max = late;
+
+    // every tick whose deadline has passed is due; advance the schedule past
+    // all of them so the game keeps its phase even when some are skipped
+    int due = 1 + (int)((now - _next) / _tick);
+    _next += _tick * due;
+    if (due > _max_catch_up) {
+        _stats.skipped += due - _max_catch_up;
+        due = _max_catch_up;
+    }
+
+    _stats.frames++;
+    _stats.updates += due;
+    return due;
+}
+
+void GameLoop::set_tick(Kernel::Clock::duration tick) {
+    if (tick.count() > 0) _tick = tick;
+}
+
+Kernel::Clock::duration GameLoop::get_tick() const { return _tick; }
+
+LoopStats GameLoop::get_stats() const { return _stats; }
+
+void GameLoop::reset_stats() { memset(&_stats, 0, sizeof(_stats)); }
+
+void GameLoop::print_stats(char const *name) const {
+    uint32_t frames = _stats.frames ? _stats.frames : 1;
+    printf("%s: %u frames, %u updates, %u overruns, %u skipped, jitter avg %u ms max %u ms\n",
+           name, (unsigned)_stats.frames, (unsigned)_stats.updates,
+           (unsigned)_stats.overruns, (unsigned)_stats.skipped,
+           (unsigned)(_stats.late_total / frames), (unsigned)_stats.late_max);
+}
@@ -0,0 +1,65 @@
+#ifndef GAMELOOP_H
+#define GAMELOOP_H
+
+#include "mbed.h"
+
+/** GameLoop Class
+@brief Fixed-timestep loop scheduled against absolute Kernel::Clock deadlines
+
+Sleeping for a fixed time after each frame makes the frame period equal to the
+work time plus the sleep, so the game slows down whenever drawing gets slower.
+GameLoop instead keeps a schedule of deadlines one tick apart. wait() sleeps
+until the next deadline and returns how many simulation updates are due: one
+normally, more if the last frame overran and the game needs to catch up, with
+any backlog beyond max_catch_up skipped rather than replayed.
+
+Example:
+
+@code
+
+GameLoop loop(100ms);
+loop.start();
+while (running) {
+    int updates = loop.wait();
+    for (int i = 0; i < updates; i++) update();
+    draw();
+    lcd.refresh();
+}
+loop.print_stats("Game");
+
+@endcode
+*/
+
+/// Timing statistics gathered by a GameLoop
+struct LoopStats {
+    uint32_t frames;      // calls to wait(), i.e. frames rendered
+    uint32_t updates;     // simulation ticks handed out
+    uint32_t overruns;    // frames whose work ran past the next deadline
+    uint32_t skipped;     // ticks dropped because the catch-up limit was hit
+    uint32_t late_total;  // sum of wake-up lateness in ms (jitter)
+    uint32_t late_max;    // worst wake-up lateness in ms
+};
+
+class GameLoop
+{
+public:
+    GameLoop(Kernel::Clock::duration tick = 100ms, int max_catch_up = 4);
+
+    void start();                                // first deadline is now
+    void resync();                               // after a blocking pause, restart the schedule from now
+    int wait();                                  // sleep to the next deadline, returns updates due (>= 1)
+    void set_tick(Kernel::Clock::duration tick); // change rate, keeping the current deadline
+    Kernel::Clock::duration get_tick() const;
+
+    LoopStats get_stats() const;
+    void reset_stats();
+    void print_stats(char const *name) const;
+
+private:
+    Kernel::Clock::duration _tick;
+    Kernel::Clock::time_point _next;
+    int _max_catch_up;
+    LoopStats _stats;
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include "InputRecorder.h"
+
+static bool same_frame(InputFrame const &a, InputFrame const &b) {
+    return a.d == b.d && a.mag == b.mag && a.buttons == b.buttons;
+}
+
+static InputFrame idle_frame() {
+    InputFrame f = {CENTRE, 0, 0};
+    return f;
+}
+
+InputRecorder::InputRecorder(uint8_t *buffer, size_t capacity)
+    : _buffer(buffer), _capacity(capacity), _size(0), _frames(0),
+      _last(idle_frame()), _run(0), _full(false) { }
+
+void InputRecorder::begin(uint32_t seed) {
+    _size = 0;
+    _frames = 0;
+    _last = idle_frame();
+    _run = 0;
+    _full = false;
+
+    uint8_t header[INPUT_HEADER_BYTES] = {
+        'I', 'R', INPUT_RECORDING_VERSION, 0,
+        (uint8_t)seed, (uint8_t)(seed >> 8), (uint8_t)(seed >> 16), (uint8_t)(seed >> 24)
+    };
+    emit(header, sizeof(header));
+}
+
+bool InputRecorder::record(InputFrame const &frame) {
+    if (_full) return false;
+
+    if (same_frame(frame, _last)) {
+        _run++;
+        if (_run == 128 && !flush_run()) return false;
+    } else {
+        if (!flush_run()) return false;
+
+        uint8_t bytes[2];
+        size_t n;
+        uint8_t buttons = frame.buttons & 0x03;
+        if (frame.d == _last.d) {
+            bytes[0] = 0x40 | (buttons << 4) | (frame.mag & 0x0F);
+            n = 1;
+        } else {
+            bytes[0] = (buttons << 4) | ((uint8_t)frame.d & 0x0F);
+            bytes[1] = frame.mag & 0x0F;
+            n = 2;
+        }
+        if (!emit(bytes, n)) return false;
+        _last = frame;
+    }
+    _frames++;
+    return true;
+}
+
+void InputRecorder::finish() { flush_run(); }
+
+bool InputRecorder::flush_run() {
+    if (_run == 0) return true;
+    uint8_t byte = 0x80 | (uint8_t)(_run - 1);
+    _run = 0;
+    return emit(&byte, 1);
+}
+
+bool InputRecorder::emit(uint8_t const *bytes, size_t n) {
+    if (_size + n > _capacity) {
+        _full = true;
+        return false;
+    }
+    for (size_t i = 0; i < n; i++) _buffer[_size++] = bytes[i];
+    return true;
+}
+
+uint8_t const *InputRecorder::data() const { return _buffer; }
+
+size_t InputRecorder::size() const { return _size; }
+
+uint32_t InputRecorder::frames() const { return _frames; }
+
+bool InputRecorder::full() const { return _full; }
+
+
+InputPlayer::InputPlayer()
+    : _data(nullptr), _size(0), _pos(0), _seed(0), _frames(0),
+      _last(idle_frame()), _pending(0) { }
+
+bool InputPlayer::open(uint8_t const *data, size_t size) {
+    _data = nullptr;
+    _size = 0;
+    _pos = 0;
+    _frames = 0;
+    _last = idle_frame();
+    _pending = 0;
+
+    if (size < INPUT_HEADER_BYTES || data[0] != 'I' || data[1] != 'R' ||
+        data[2] != INPUT_RECORDING_VERSION) {
+        return false;
+    }
+    _seed = (uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+            ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+    _data = data;
+    _size = size;
+    _pos = INPUT_HEADER_BYTES;
+    return true;
+}
+
+bool InputPlayer::next(InputFrame &frame) {
+    if (_pending > 0) {
+        _pending--;
+    } else {
+        if (_pos >= _size) return false;
+        uint8_t byte = _data[_pos++];
+
+        if (byte & 0x80) {
+            _pending = byte & 0x7F;  // this call hands out the first repeat
+        } else if (byte & 0x40) {
+            _last.buttons = (byte >> 4) & 0x03;
+            _last.mag = byte & 0x0F;
+        } else {
+            if (_pos >= _size) return false;  // truncated literal
+            _last.buttons = (byte >> 4) & 0x03;
+            _last.d = (Direction)(byte & 0x0F);
+            _last.mag = _data[_pos++] & 0x0F;
+        }
+    }
+    frame = _last;
+    _frames++;
+    return true;
+}
+
+uint32_t InputPlayer::seed() const { return _seed; }
+
+uint32_t InputPlayer::frames() const { return _frames; }
+
+bool InputPlayer::done() const { return _pending == 0 && _pos >= _size; }
@@ -0,0 +1,74 @@
+#ifndef INPUTRECORDER_H
+#define INPUTRECORDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Utils.h"
+
+/** InputRecorder / InputPlayer
+@brief Compact delta-encoded log of per-frame input snapshots
+
+A recording starts with an 8 byte header ('I','R', version, 0, seed as 32-bit
+little endian) followed by a stream where every byte describes the next frame(s)
+relative to the previous one:
+
+    1rrrrrrr            previous frame repeated r+1 times (1 to 128 frames)
+    01bbmmmm            new buttons and magnitude, same direction
+    00bbdddd 0000mmmm   new buttons, direction and magnitude
+
+An idle joystick therefore costs one byte per 128 frames. Neither class touches
+hardware: they only turn frames into bytes and back.
+*/
+#define INPUT_RECORDING_VERSION 1
+#define INPUT_HEADER_BYTES 8
+
+class InputRecorder
+{
+public:
+    InputRecorder(uint8_t *buffer, size_t capacity);
+
+    void begin(uint32_t seed);              // start a new recording, writing the header
+    bool record(InputFrame const &frame);   // false once the buffer is full
+    void finish();                          // flush any pending run, call before using data()
+
+    uint8_t const *data() const;
+    size_t size() const;                    // bytes used, including the header
+    uint32_t frames() const;                // frames recorded
+    bool full() const;
+
+private:
+    bool emit(uint8_t const *bytes, size_t n);
+    bool flush_run();
+
+    uint8_t *_buffer;
+    size_t _capacity;
+    size_t _size;
+    uint32_t _frames;
+    InputFrame _last;
+    uint8_t _run;       // frames equal to _last not yet written
+    bool _full;
+};
+
+class InputPlayer
+{
+public:
+    InputPlayer();
+
+    bool open(uint8_t const *data, size_t size);  // false if the header is not valid
+    bool next(InputFrame &frame);                 // false when the recording is exhausted
+
+    uint32_t seed() const;
+    uint32_t frames() const;                      // frames played so far
+    bool done() const;
+
+private:
+    uint8_t const *_data;
+    size_t _size;
+    size_t _pos;
+    uint32_t _seed;
+    uint32_t _frames;
+    InputFrame _last;
+    uint8_t _pending;   // repeats of _last still to hand out
+};
+
+#endif
@@ -0,0 +1,167 @@
+#include "InputSource.h"
+#include "hal/us_ticker_api.h"
+#include <ctime>
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME  16777619u
+
+InputSource::InputSource(Joystick &joystick, DigitalIn &select)
+    : _joystick(joystick), _select(select),
+      _mode(INPUT_LIVE), _in_session(false), _hash(FNV_OFFSET), _recorded_hash(0),
+      _store_size(0), _recorder(_store, INPUT_RECORD_BYTES),
+      _sampler(osPriorityAboveNormal, 1024, nullptr, "input"), _period(10ms),
+      _sampling(false), _seq(0), _slot_us(0), _sampled_us(0), _sample_max_us(0) {
+    _slot.d = CENTRE;
+    _slot.mag = 0;
+    _slot.buttons = 0;
+}
+
+void InputSource::set_mode(Mode mode) {
+    // can't replay without something to replay
+    if (mode == INPUT_REPLAY && !has_recording()) mode = INPUT_LIVE;
+    _mode = mode;
+}
+
+InputSource::Mode InputSource::get_mode() const { return _mode; }
+
+bool InputSource::has_recording() const { return _store_size > INPUT_HEADER_BYTES; }
+
+void InputSource::dump_recording() const {
+    static const char HEX[] = "0123456789ABCDEF";
+    char line[65];
+    printf("REC %u bytes\n", (unsigned)_store_size);
+    // built by hand - minimal-printf has no zero padding for %02X
+    for (size_t i = 0; i < _store_size; i += 32) {
+        int n = 0;
+        for (size_t j = i; j < _store_size && j < i + 32; j++) {
+            line[n++] = HEX[_store[j] >> 4];
+            line[n++] = HEX[_store[j] & 0x0F];
+        }
+        line[n] = '\0';
+        printf("%s\n", line);
+    }
+}
+
+uint32_t InputSource::begin_session() {
+    uint32_t seed = (uint32_t)time(NULL);
+    _hash = FNV_OFFSET;
+    _in_session = true;
+
+    if (_mode == INPUT_RECORD) {
+        // time() may not be set on the board, so mix in the kernel tick count
+        seed ^= (uint32_t)Kernel::Clock::now().time_since_epoch().count();
+        _recorder.begin(seed);
+    } else if (_mode == INPUT_REPLAY) {
+        _player.open(_store, _store_size);
+        seed = _player.seed();
+    }
+    return seed;
+}
+
+void InputSource::end_session() {
+    if (!_in_session) return;
+    _in_session = false;
+
+    if (_mode == INPUT_RECORD) {
+        _recorder.finish();
+        _store_size = _recorder.size();
+        _recorded_hash = _hash;
+        printf("Recorded %u frames in %u bytes%s, hash %X\n",
+               (unsigned)_recorder.frames(), (unsigned)_store_size,
+               _recorder.full() ? " (truncated)" : "", (unsigned)_hash);
+        dump_recording();
+    } else if (_mode == INPUT_REPLAY) {
+        printf("Replayed %u frames, hash %X", (unsigned)_player.frames(), (unsigned)_hash);
+        if (_recorded_hash) printf(" %s", _hash == _recorded_hash ? "(match)" : "(MISMATCH)");
+        printf("\n");
+    }
+}
+
+void InputSource::hash_state(uint32_t state) {
+    if (!_in_session || _mode == INPUT_LIVE) return;
+    _hash = (_hash ^ state) * FNV_PRIME;
+}
+
+InputFrame InputSource::sample() {
+    InputFrame frame;
+    if (_in_session && _mode == INPUT_REPLAY) {
+        if (!_player.next(frame)) {
+            // out of input - press select so the game exits the way it was left
+            frame.d = CENTRE;
+            frame.mag = 0;
+            frame.buttons = BUTTON_SELECT;
+        }
+        return frame;
+    }
+
+    frame = read_live();
+    if (_in_session && _mode == INPUT_RECORD) _recorder.record(frame);
+    return frame;
+}
+
+void InputSource::start_sampler(Kernel::Clock::duration period) {
+    if (_sampling) return;
+    _period = period;
+    _sampling = true;
+    _sampler.start(callback(this, &InputSource::sampler_main));
+}
+
+void InputSource::set_sample_period(Kernel::Clock::duration period) {
+    _period = period;  // picked up by the input thread after its next read
+}
+
+Kernel::Clock::duration InputSource::sample_period() const { return _period; }
+
+uint32_t InputSource::sampled_at() const { return _sampled_us; }
+
+uint32_t InputSource::sample_time_max() const { return _sample_max_us; }
+
+void InputSource::sampler_main() {
+    Kernel::Clock::time_point next = Kernel::Clock::now();
+    while (true) {
+        uint32_t start = us_ticker_read();
+        InputFrame frame = read_hardware();
+        uint32_t took = us_ticker_read() - start;
+        if (took > _sample_max_us) _sample_max_us = took;
+
+        // single writer: bump to odd, write, bump to even
+        core_util_atomic_store_u32(&_seq, _seq + 1);
+        _slot = frame;
+        _slot_us = start;
+        core_util_atomic_store_u32(&_seq, _seq + 1);
+
+        next += _period;
+        ThisThread::sleep_until(next);
+    }
+}
+
+InputFrame InputSource::read_live() {
+    if (!_sampling) {
+        _sampled_us = us_ticker_read();
+        return read_hardware();
+    }
+
+    // retry if the input thread wrote the slot while we were copying it
+    InputFrame frame;
+    uint32_t seq;
+    do {
+        seq = core_util_atomic_load_u32(&_seq);
+        frame = _slot;
+        _sampled_us = _slot_us;
+    } while ((seq & 1) || seq != core_util_atomic_load_u32(&_seq));
+    return frame;
+}
+
+InputFrame InputSource::read_hardware() {
+    UserInput in = _joystick.get_input();
+    int mag = (int)(in.mag * 15.0f + 0.5f);
+    if (mag > 15) mag = 15;
+
+    InputFrame frame;
+    frame.d = in.d;
+    frame.mag = (uint8_t)mag;
+    frame.buttons = 0;
+    if (_joystick.button_pressed()) frame.buttons |= BUTTON_JOY;
+    if (_select.read() == 0) frame.buttons |= BUTTON_SELECT;  // active low
+    return frame;
+}
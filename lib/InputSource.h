@@ -0,0 +1,88 @@
+#ifndef INPUTSOURCE_H
+#define INPUTSOURCE_H
+
+#include "mbed.h"
+#include "Joystick.h"
+#include "InputRecorder.h"
+#include "Utils.h"
+
+// size of the in-RAM recording - an idle stick costs 1 byte per 128 frames
+#define INPUT_RECORD_BYTES 4096
+
+/** InputSource Class
+@brief Single place the games read their per-frame input from
+
+In INPUT_LIVE mode this just reads the joystick and select button. In
+INPUT_RECORD mode every frame sampled between begin_session() and end_session()
+is also logged, and in INPUT_REPLAY mode the frames (and the session seed) come
+back out of the last recording instead of the hardware. Replaying a session
+therefore gives the same game, which makes frame timings comparable.
+
+A running hash of the game's state is kept for the session, so a replay can be
+checked against the original run. Whoever drives the game calls hash_state()
+after every update with the scene's state(): the screen isn't used, as what
+gets drawn depends on load (skipped frames, quality drops, the profiler's
+overlay) while the state after each update only depends on the input.
+
+start_sampler() moves the hardware reads onto their own thread. The latest
+snapshot is published through a lock-free sequence-counted slot, so sample()
+never waits on the ADC and the game thread can't see a half-written snapshot.
+*/
+class InputSource
+{
+public:
+    enum Mode {
+        INPUT_LIVE,    ///< read the hardware only
+        INPUT_RECORD,  ///< read the hardware and log each session
+        INPUT_REPLAY,  ///< feed back the last recording
+    };
+
+    InputSource(Joystick &joystick, DigitalIn &select);
+
+    void set_mode(Mode mode);
+    Mode get_mode() const;
+
+    bool has_recording() const;
+    void dump_recording() const;                  // hex dump of the recording over serial
+
+    uint32_t begin_session();   // start of a game - returns the seed for its Random
+    void end_session();         // end of a game - prints frame count and output hash
+    InputFrame sample();        // input for the current frame
+    void hash_state(uint32_t state);  // fold the state after an update into the session hash
+
+    void start_sampler(Kernel::Clock::duration period);  // read the hardware on an input thread
+    void set_sample_period(Kernel::Clock::duration period);  // e.g. slow down while idle
+    Kernel::Clock::duration sample_period() const;
+    uint32_t sampled_at() const;                          // us timestamp of the snapshot last returned
+    uint32_t sample_time_max() const;                     // worst hardware read time in us
+
+private:
+    InputFrame read_live();
+    InputFrame read_hardware();
+    void sampler_main();
+
+    Joystick &_joystick;
+    DigitalIn &_select;
+
+    Mode _mode;
+    bool _in_session;
+    uint32_t _hash;
+    uint32_t _recorded_hash;
+
+    uint8_t _store[INPUT_RECORD_BYTES];
+    size_t _store_size;
+    InputRecorder _recorder;
+    InputPlayer _player;
+
+    // input thread and the slot it publishes to
+    Thread _sampler;
+    Kernel::Clock::duration _period;
+    bool _sampling;
+    volatile uint32_t _seq;     // odd while the slot is being written
+    InputFrame _slot;
+    uint32_t _slot_us;
+    uint32_t _sampled_us;
+    uint32_t _sample_max_us;
+};
+
+#endif
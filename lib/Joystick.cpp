@@ -31,10 +31,9 @@ void Joystick::init()
     // not be the case and x0 and y0 will be used to calibrate readings
 }
 
-Direction Joystick::get_direction()
+// partition a compass angle (0 to 360, -1 for centred) into a Direction
+static Direction angle_to_direction(float angle)
 {
-    float angle = get_angle();  // 0 to 360, -1 for centred
-
     Direction d;
     // partition 360 into segments and check which segment the angle is in
     if (angle < 0.0f) {
@@ -62,6 +61,20 @@ Direction Joystick::get_direction()
     return d;
 }
 
+Direction Joystick::get_direction()
+{
+    float angle = get_angle();  // 0 to 360, -1 for centred
+    return angle_to_direction(angle);
+}
+
+// direction and magnitude from one set of ADC readings, so the two always agree
+UserInput Joystick::get_input()
+{
+    Polar p = get_polar();
+    UserInput input = {angle_to_direction(p.angle), p.mag};
+    return input;
+}
+
 // this method gets the magnitude of the joystick movement
 float Joystick::get_mag() {
     Polar p = get_polar();
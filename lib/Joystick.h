@@ -66,6 +66,7 @@ public:
     Vector2D get_mapped_coord();  // x,y mapped to circle
     Direction get_direction();    // N,NE,E,SE etc.
     Polar get_polar();            // mag and angle in struct form
+    UserInput get_input();        // direction and mag from a single reading
 
     bool button_pressed();        // <- NEW: check button press
 
@@ -0,0 +1,141 @@
+#include "Log.h"
+#include "hal/us_ticker_api.h"
+
+#define LOG_SYNC 0xA5
+#define LOG_DRAIN_PERIOD 50ms
+
+// One record. seq says whose turn the slot is: pos when free for the producer
+// claiming position pos, pos + 1 once that record is ready for the consumer.
+struct LogSlot {
+    volatile uint32_t seq;
+    uint32_t time;
+    uint16_t id;
+    uint8_t level;
+    uint8_t count;
+    int32_t args[LOG_MAX_ARGS];
+};
+
+static LogSlot slots[LOG_SLOTS];
+static volatile uint32_t enqueue_pos = 0;
+static volatile uint32_t dequeue_pos = 0;
+static volatile uint32_t lost = 0;
+static bool slots_ready = false;
+static Thread drain_thread(osPriorityLow, 1024, nullptr, "log");
+
+static void init_slots() {
+    for (uint32_t i = 0; i < LOG_SLOTS; i++) slots[i].seq = i;
+    slots_ready = true;
+}
+
+void Log::record(uint8_t level, LogId id, int32_t const *args, int count) {
+    if (!slots_ready) init_slots();  // first record before start()
+
+    // claim a slot
+    LogSlot *slot;
+    uint32_t pos = core_util_atomic_load_u32(&enqueue_pos);
+    while (true) {
+        slot = &slots[pos & (LOG_SLOTS - 1)];
+        int32_t diff = (int32_t)(core_util_atomic_load_u32(&slot->seq) - pos);
+        if (diff == 0) {
+            if (core_util_atomic_cas_u32(&enqueue_pos, &pos, pos + 1)) break;  // pos reloaded on failure
+        } else if (diff < 0) {
+            core_util_atomic_incr_u32(&lost, 1);  // full - the drain thread is behind
+            return;
+        } else {
+            pos = core_util_atomic_load_u32(&enqueue_pos);  // another producer took it
+        }
+    }
+
+    slot->time = us_ticker_read();
+    slot->id = id;
+    slot->level = level;
+    slot->count = count;
+    for (int i = 0; i < count; i++) slot->args[i] = args[i];
+    core_util_atomic_store_u32(&slot->seq, pos + 1);  // publish
+}
+
+// Takes the oldest record, false if the ring is empty
+static bool take(LogSlot &out) {
+    LogSlot *slot;
+    uint32_t pos = core_util_atomic_load_u32(&dequeue_pos);
+    while (true) {
+        slot = &slots[pos & (LOG_SLOTS - 1)];
+        int32_t diff = (int32_t)(core_util_atomic_load_u32(&slot->seq) - (pos + 1));
+        if (diff == 0) {
+            if (core_util_atomic_cas_u32(&dequeue_pos, &pos, pos + 1)) break;
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = core_util_atomic_load_u32(&dequeue_pos);
+        }
+    }
+
+    out.time = slot->time;
+    out.id = slot->id;
+    out.level = slot->level;
+    out.count = slot->count;
+    for (int i = 0; i < out.count; i++) out.args[i] = slot->args[i];
+    core_util_atomic_store_u32(&slot->seq, pos + LOG_SLOTS);  // free for the next lap
+    return true;
+}
+
+static int put32(uint8_t *p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+    return 4;
+}
+
+// Frames a record as described in Log.h, returns its length
+static int encode(LogSlot const &r, uint8_t *frame) {
+    int n = 2;
+    frame[n++] = r.id;
+    frame[n++] = r.id >> 8;
+    frame[n++] = (r.level << 4) | r.count;
+    n += put32(frame + n, r.time);
+    for (int i = 0; i < r.count; i++) n += put32(frame + n, r.args[i]);
+
+    uint8_t sum = 0;
+    for (int i = 2; i < n; i++) sum += frame[i];
+    frame[0] = LOG_SYNC;
+    frame[1] = n - 2;
+    frame[n++] = sum;
+    return n;
+}
+
+void Log::drain_main() {
+    FileHandle *out = mbed_file_handle(STDOUT_FILENO);
+    uint8_t frame[2 + 7 + 4 * LOG_MAX_ARGS + 1];
+    uint32_t reported = 0;
+
+    while (true) {
+        uint32_t now_lost = core_util_atomic_load_u32(&lost);
+        if (now_lost != reported) {
+            LogSlot r;
+            r.time = us_ticker_read();
+            r.id = LOG_DROPPED;
+            r.level = LOG_LEVEL_WARN;
+            r.count = 1;
+            r.args[0] = now_lost - reported;
+            reported = now_lost;
+            out->write(frame, encode(r, frame));
+        }
+
+        LogSlot r;
+        if (!take(r)) {
+            ThisThread::sleep_for(LOG_DRAIN_PERIOD);
+            continue;
+        }
+        // the console is buffered, so this only waits when its buffer is full,
+        // and then only this thread does
+        out->write(frame, encode(r, frame));
+    }
+}
+
+void Log::start() {
+    if (!slots_ready) init_slots();
+    drain_thread.start(Log::drain_main);
+}
+
+uint32_t Log::dropped() { return core_util_atomic_load_u32(&lost); }
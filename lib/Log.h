@@ -0,0 +1,97 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include "mbed.h"
+#include "LogFormats.h"
+
+// Levels, most severe first. Sites above app.log-level compile to nothing.
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+#define LOG_LEVEL_TRACE 5
+
+#ifndef MBED_CONF_APP_LOG_LEVEL
+#define MBED_CONF_APP_LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_MAX_ARGS 4
+#define LOG_SLOTS 32    // records the ring can hold - a power of two
+
+/** Log Class
+@brief Deferred binary logging that never blocks the thread logging
+
+A log site stores a record - format ID, level, us time-stamp and up to four
+raw 32-bit arguments - in a lock-free ring of fixed slots (a bounded MPMC
+queue with a sequence number per slot), so any thread can log without taking
+a lock and without formatting anything. When the ring is full the record is
+dropped and counted rather than waited for.
+
+A low-priority thread started by start() drains the ring to the console in
+frames of
+
+    0xA5, length, id (2 bytes), level << 4 | arg count, time (4), args (4 each), checksum
+
+all little-endian, with the checksum the low byte of the sum of everything
+after the length. Text from printf can share the line: it is plain ASCII, so
+tools/logdecode.py prints it as it is and only decodes from 0xA5 on.
+
+Use the macros rather than write(), so sites above app.log-level vanish:
+
+@code
+
+LOG_TRACE(LOG_EXPLORE_PLAYER, playerX, playerY, tile);
+LOG_WARN(LOG_GOVERNOR_DROP, average, budget, level);
+
+@endcode
+*/
+class Log
+{
+public:
+    static void start();          // start the drain thread
+    static uint32_t dropped();    // records lost to a full ring since boot
+
+    template <typename... Args>
+    static void write(uint8_t level, LogId id, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+        int32_t const values[sizeof...(Args) + 1] = { (int32_t)args..., 0 };
+        record(level, id, values, sizeof...(Args));
+    }
+
+private:
+    static void record(uint8_t level, LogId id, int32_t const *args, int count);
+    static void drain_main();
+};
+
+#if MBED_CONF_APP_LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(id, ...) Log::write(LOG_LEVEL_ERROR, id, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(id, ...) do { } while (0)
+#endif
+
+#if MBED_CONF_APP_LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(id, ...) Log::write(LOG_LEVEL_WARN, id, ##__VA_ARGS__)
+#else
+#define LOG_WARN(id, ...) do { } while (0)
+#endif
+
+#if MBED_CONF_APP_LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(id, ...) Log::write(LOG_LEVEL_INFO, id, ##__VA_ARGS__)
+#else
+#define LOG_INFO(id, ...) do { } while (0)
+#endif
+
+#if MBED_CONF_APP_LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(id, ...) Log::write(LOG_LEVEL_DEBUG, id, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(id, ...) do { } while (0)
+#endif
+
+#if MBED_CONF_APP_LOG_LEVEL >= LOG_LEVEL_TRACE
+#define LOG_TRACE(id, ...) Log::write(LOG_LEVEL_TRACE, id, ##__VA_ARGS__)
+#else
+#define LOG_TRACE(id, ...) do { } while (0)
+#endif
+
+#endif
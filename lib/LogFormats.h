@@ -0,0 +1,37 @@
+#ifndef LOGFORMATS_H
+#define LOGFORMATS_H
+
+/*
+ * Every log message the firmware can send. Only the position in this table
+ * goes over the wire, so the text and tag live in flash here and in the host
+ * decoder (tools/logdecode.py reads this file), never in the record.
+ *
+ * Arguments are sent as raw 32-bit integers: use %d, %u or %x only, and add
+ * new entries at the end so older captures still decode.
+ *
+ *  X(id,                  tag,        format)
+ */
+#define LOG_FORMATS(X) \
+    X(LOG_DROPPED,         "Log",      "%u records dropped, ring full") \
+    X(LOG_PADDLE_INIT,     "Paddle",   "Init") \
+    X(LOG_PADDLE_DRAW,     "Paddle",   "Draw") \
+    X(LOG_PADDLE_UPDATE,   "Paddle",   "Update") \
+    X(LOG_BALL_VELOCITY,   "Ball",     "Velocity (%d,%d)") \
+    X(LOG_BALL_POSITION,   "Ball",     "Set Position (%d,%d)") \
+    X(LOG_EXPLORE_PLAYER,  "Explore",  "Player at (%d,%d), Tile = %d") \
+    X(LOG_GOVERNOR_DROP,   "Governor", "frame avg %u us over %u us budget, dropping level %d") \
+    X(LOG_GOVERNOR_RESTORE,"Governor", "frame avg %u us of %u us budget, restoring level %d") \
+    X(LOG_MAPS_FAILED,     "Maps",     "slot %d: store error %d") \
+    X(LOG_MAPS_LOAD,       "Maps",     "slot %d loaded in %u us, %u bytes") \
+    X(LOG_MAPS_SAVE,       "Maps",     "slot %d saved in %u us, %u bytes") \
+    X(LOG_MAPS_UNCHANGED,  "Maps",     "slot %d unchanged, not rewritten") \
+    X(LOG_MAPS_WEAR,       "Maps",     "flash since boot: %u bytes programmed, %u erased")
+
+#define LOG_ID_ENUM(id, tag, format) id,
+enum LogId {
+    LOG_FORMATS(LOG_ID_ENUM)
+    LOG_ID_COUNT
+};
+#undef LOG_ID_ENUM
+
+#endif
@@ -0,0 +1,93 @@
+#include "MapCodec.h"
+
+// Bit at a time rather than a 1 KB table: maps are a few hundred bytes
+uint32_t map_crc(uint32_t crc, uint8_t byte) {
+    crc ^= byte;
+    for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1));
+    return crc;
+}
+
+MapEncoder::MapEncoder(Callback<void(uint8_t)> out) : _out(out), _crc(0), _tile(0), _run(0) { }
+
+void MapEncoder::put(uint8_t byte) {
+    _crc = map_crc(_crc, byte);
+    _out(byte);
+}
+
+void MapEncoder::begin(int width, int height) {
+    _crc = 0xFFFFFFFFu;
+    _run = 0;
+    for (int i = 0; i < 4; i++) put(MAP_MAGIC[i]);
+    put(width & 0xFF);
+    put(width >> 8);
+    put(height);
+    put(MAP_TILESET);
+}
+
+void MapEncoder::flush_run() {
+    if (_run > 0) put(((_run - 1) << 4) | _tile);
+    _run = 0;
+}
+
+void MapEncoder::tile(uint8_t tile) {
+    if (_run == 16 || (_run > 0 && tile != _tile)) flush_run();
+    _tile = tile & 0x0F;
+    _run++;
+}
+
+void MapEncoder::end() {
+    flush_run();
+    uint32_t crc = ~_crc;
+    for (int i = 0; i < 4; i++) _out((crc >> (8 * i)) & 0xFF);
+}
+
+MapDecoder::MapDecoder(Callback<void(int, int, uint8_t)> out)
+    : _out(out), _width(0), _height(0), _offset(0), _tiles(0), _crc_bytes(0), _crc(0), _stored_crc(0),
+      _status(MAP_ERROR) { }
+
+void MapDecoder::begin(int width, int height) {
+    _width = width;
+    _height = height;
+    _offset = 0;
+    _tiles = 0;
+    _crc_bytes = 0;
+    _crc = 0xFFFFFFFFu;
+    _stored_crc = 0;
+    _status = MAP_MORE;
+}
+
+MapDecoder::Status MapDecoder::fail() {
+    _status = MAP_ERROR;
+    return _status;
+}
+
+MapDecoder::Status MapDecoder::status() const { return _status; }
+
+MapDecoder::Status MapDecoder::push(uint8_t byte) {
+    if (_status != MAP_MORE) return _status;
+    int total = _width * _height;
+
+    if (_offset < MAP_HEADER_BYTES) {
+        _crc = map_crc(_crc, byte);
+        _header[_offset++] = byte;
+        if (_offset == MAP_HEADER_BYTES &&
+            (memcmp(_header, MAP_MAGIC, 4) != 0 || (_header[4] | (_header[5] << 8)) != _width ||
+             _header[6] != _height || _header[7] != MAP_TILESET)) {
+            return fail();
+        }
+        return _status;
+    }
+
+    if (_tiles < total) {
+        _crc = map_crc(_crc, byte);
+        int run = (byte >> 4) + 1;
+        if (_tiles + run > total) return fail();
+        for (; run > 0; run--, _tiles++) _out(_tiles % _width, _tiles / _width, byte & 0x0F);
+        return _status;
+    }
+
+    // then the CRC, low byte first
+    _stored_crc |= (uint32_t)byte << (8 * _crc_bytes++);
+    if (_crc_bytes == 4) _status = _stored_crc == ~_crc ? MAP_DONE : MAP_ERROR;
+    return _status;
+}
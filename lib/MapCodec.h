@@ -0,0 +1,98 @@
+#ifndef MAPCODEC_H
+#define MAPCODEC_H
+
+#include "mbed.h"
+
+/*
+ * Binary map format, all numbers little-endian:
+ *
+ *   "MXM1"        magic
+ *   uint16 width  in tiles
+ *   uint8 height  in tiles
+ *   uint8 tileset MAP_TILESET when written; maps from another tileset are refused
+ *   runs...       one byte per run of tiles in row order: (length - 1) << 4 | tile
+ *   uint32 crc    CRC-32 (as zlib) of everything before it
+ *
+ * The runs are the same as in compressed chunks (Chunk.h), so an empty
+ * 60 x 8 map is 42 bytes. tools/mapconv.py reads and writes the format.
+ */
+#define MAP_MAGIC "MXM1"
+#define MAP_HEADER_BYTES 8
+#define MAP_TILESET 1  // bump when tile IDs change meaning
+
+/// Running CRC-32: start from 0xFFFFFFFF, invert the result when done
+uint32_t map_crc(uint32_t crc, uint8_t byte);
+
+/** MapEncoder Class
+@brief Writes a map in the binary format a tile at a time
+
+Keeps only the current run and the CRC, so a map of any size is encoded in
+a few bytes of RAM; every output byte goes to the callback as it is made.
+
+Example:
+
+@code
+
+MapEncoder encoder(callback(this, &Link::put));
+encoder.begin(MAP_WIDTH, MAP_HEIGHT);
+for (int y = 0; y < MAP_HEIGHT; y++)
+    for (int x = 0; x < MAP_WIDTH; x++) encoder.tile(map.get(x, y));
+encoder.end();
+
+@endcode
+*/
+class MapEncoder
+{
+public:
+    MapEncoder(Callback<void(uint8_t)> out);
+
+    void begin(int width, int height);
+    void tile(uint8_t tile);
+    void end();
+
+private:
+    void put(uint8_t byte);
+    void flush_run();
+
+    Callback<void(uint8_t)> _out;
+    uint32_t _crc;
+    uint8_t _tile;
+    int _run;
+};
+
+/** MapDecoder Class
+@brief Reads a map in the binary format a byte at a time
+
+begin() says what size of map is expected; push() then takes the bytes as
+they arrive and hands each tile to the callback. It returns MAP_MORE until
+the CRC has been read, then MAP_DONE, or MAP_ERROR for a wrong header,
+size or tileset, a bad run or a CRC mismatch - after which it ignores
+everything until the next begin(). Tile IDs are passed on as they are, and
+before the CRC is checked, so decode into scratch space and only keep it on
+MAP_DONE.
+*/
+class MapDecoder
+{
+public:
+    enum Status { MAP_MORE, MAP_DONE, MAP_ERROR };
+
+    MapDecoder(Callback<void(int x, int y, uint8_t tile)> out);
+
+    void begin(int width, int height);
+    Status push(uint8_t byte);
+    Status status() const;
+
+private:
+    Status fail();
+
+    Callback<void(int, int, uint8_t)> _out;
+    int _width, _height;
+    int _offset;         // header bytes read so far
+    int _tiles;          // tiles decoded so far
+    int _crc_bytes;
+    uint8_t _header[MAP_HEADER_BYTES];
+    uint32_t _crc, _stored_crc;
+    Status _status;
+};
+
+#endif
@@ -0,0 +1,119 @@
+#include "MapLink.h"
+
+MapLink::MapLink()
+    : _encoder(callback(this, &MapLink::put)), _decoder(callback(this, &MapLink::put_tile)),
+      _out_length(0), _out_seq(0), _sent(0), _in_length(0), _in_seq(0), _receiving(false),
+      _scratch(nullptr) { }
+
+void MapLink::send_frame(uint8_t type, uint8_t seq, uint8_t const *payload, int length) {
+    uint8_t frame[4 + MAP_FRAME_PAYLOAD + 1];
+    frame[0] = MAP_SYNC;
+    frame[1] = type;
+    frame[2] = seq;
+    frame[3] = length;
+    memcpy(frame + 4, payload, length);
+
+    uint8_t sum = 0;
+    for (int i = 1; i < 4 + length; i++) sum += frame[i];
+    frame[4 + length] = sum;
+
+    // one write per frame, so log records from the drain thread can't land inside it
+    mbed_file_handle(STDOUT_FILENO)->write(frame, 5 + length);
+}
+
+// Encoder output: fill DATA frames
+void MapLink::put(uint8_t byte) {
+    _out[_out_length++] = byte;
+    _sent++;
+    if (_out_length == MAP_FRAME_PAYLOAD) {
+        send_frame(MAP_FRAME_DATA, _out_seq++, _out, _out_length);
+        _out_length = 0;
+    }
+}
+
+int MapLink::send(TileMap const &map) {
+    fflush(stdout);
+    _out_length = 0;
+    _out_seq = 0;
+    _sent = 0;
+
+    _encoder.begin(MAP_WIDTH, MAP_HEIGHT);
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) _encoder.tile(map.get(x, y));
+    }
+    _encoder.end();
+
+    if (_out_length > 0) send_frame(MAP_FRAME_DATA, _out_seq++, _out, _out_length);
+    send_frame(MAP_FRAME_END, _out_seq, nullptr, 0);
+    return _sent;
+}
+
+// Decoder output
+void MapLink::put_tile(int x, int y, uint8_t tile) {
+    if (!_scratch->set(x, y, tile)) _receiving = false;  // not a tile type: fails at END
+}
+
+MapLink::Import MapLink::frame_received() {
+    uint8_t type = _in[1], seq = _in[2], length = _in[3];
+
+    if (type == MAP_FRAME_DATA) {
+        if (seq == 0) {                     // a new map
+            _scratch->clear();
+            _decoder.begin(MAP_WIDTH, MAP_HEIGHT);
+            _in_seq = 0;
+            _receiving = true;
+        }
+        if (_receiving && seq == (uint8_t)(_in_seq - 1)) {
+            send_frame(MAP_FRAME_ACK, seq, nullptr, 0);   // our ACK was lost
+            return IMPORT_RECEIVING;
+        }
+        if (!_receiving || seq != _in_seq) {
+            _receiving = false;
+            send_frame(MAP_FRAME_NAK, seq, nullptr, 0);
+            return IMPORT_FAILED;
+        }
+        for (int i = 0; i < length; i++) _decoder.push(_in[4 + i]);
+        _in_seq++;
+        send_frame(MAP_FRAME_ACK, seq, nullptr, 0);
+        return IMPORT_RECEIVING;
+    }
+
+    if (type == MAP_FRAME_END) {
+        bool ok = _receiving && seq == _in_seq && _decoder.status() == MapDecoder::MAP_DONE;
+        _receiving = false;
+        send_frame(ok ? MAP_FRAME_ACK : MAP_FRAME_NAK, seq, nullptr, 0);
+        return ok ? IMPORT_DONE : IMPORT_FAILED;
+    }
+    return IMPORT_IDLE;
+}
+
+MapLink::Import MapLink::receive(uint8_t byte) {
+    if (_in_length == 0 && byte != MAP_SYNC) return IMPORT_IDLE;
+    _in[_in_length++] = byte;
+    if (_in_length == 4 && _in[3] > MAP_FRAME_PAYLOAD) {
+        _in_length = 0;
+        return IMPORT_IDLE;
+    }
+    if (_in_length < 4 || _in_length < 5 + _in[3]) return IMPORT_IDLE;
+
+    int length = _in_length;
+    _in_length = 0;
+    uint8_t sum = 0;
+    for (int i = 1; i < length - 1; i++) sum += _in[i];
+    if (sum != _in[length - 1]) {
+        send_frame(MAP_FRAME_NAK, _in[2], nullptr, 0);
+        return IMPORT_IDLE;
+    }
+    return frame_received();
+}
+
+bool MapLink::takes(uint8_t byte) const {
+    return _in_length > 0 || byte == MAP_SYNC;
+}
+
+MapLink::Import MapLink::push(uint8_t byte, TileMap &scratch) {
+    _scratch = &scratch;
+    Import result = receive(byte);
+    if (result == IMPORT_IDLE && _receiving) result = IMPORT_RECEIVING;
+    return result;
+}
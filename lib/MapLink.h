@@ -0,0 +1,74 @@
+#ifndef MAPLINK_H
+#define MAPLINK_H
+
+#include "mbed.h"
+#include "MapCodec.h"
+#include "TileMap.h"
+
+/*
+ * Maps travel over the console in frames, so they can share it with printf
+ * text and log records:
+ *
+ *   0x5A, type, seq, length, payload (0-32 bytes), checksum
+ *
+ * with the checksum the low byte of the sum of type to the end of the
+ * payload. A map is sent as DATA frames carrying the binary map format
+ * (MapCodec.h) with seq counting up from 0, then an END frame.
+ *
+ * When importing, the board answers every frame with an ACK or NAK of its
+ * seq, and the sender waits for it, so the console's receive buffer never
+ * overflows. A resent frame (seq one behind) is acknowledged again without
+ * being used twice; any other gap fails the import. tools/mapconv.py is the
+ * other end.
+ */
+#define MAP_SYNC 0x5A
+#define MAP_FRAME_PAYLOAD 32
+
+enum MapFrameType {
+    MAP_FRAME_DATA = 1,
+    MAP_FRAME_END = 2,
+    MAP_FRAME_ACK = 3,
+    MAP_FRAME_NAK = 4,
+};
+
+/** MapLink Class
+@brief Sends and receives editor maps over the serial console
+
+send() exports a map. MapLink doesn't read the console itself, since other
+things listen on it too: whoever does offers it each byte, and push() takes
+the ones takes() says are part of a frame, decoding into the scratch map it is
+given and returning IMPORT_DONE once a whole map has arrived intact.
+*/
+class MapLink
+{
+public:
+    enum Import { IMPORT_IDLE, IMPORT_RECEIVING, IMPORT_DONE, IMPORT_FAILED };
+
+    MapLink();
+
+    int send(TileMap const &map);   // returns the encoded size in bytes
+    bool takes(uint8_t byte) const;            // the sync that starts a frame, or any byte in one
+    Import push(uint8_t byte, TileMap &scratch);
+
+private:
+    void put(uint8_t byte);
+    void put_tile(int x, int y, uint8_t tile);
+    void send_frame(uint8_t type, uint8_t seq, uint8_t const *payload, int length);
+    Import receive(uint8_t byte);
+    Import frame_received();
+
+    MapEncoder _encoder;
+    MapDecoder _decoder;
+    uint8_t _out[MAP_FRAME_PAYLOAD];        // payload being filled by the encoder
+    int _out_length;
+    uint8_t _out_seq;
+    int _sent;
+
+    uint8_t _in[4 + MAP_FRAME_PAYLOAD + 1]; // frame being received
+    int _in_length;
+    uint8_t _in_seq;                        // next DATA frame expected
+    bool _receiving;
+    TileMap *_scratch;
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "MapStore.h"
+#include "Log.h"
+#include "hal/us_ticker_api.h"
+
+static void slot_key(int slot, char *key) {
+    snprintf(key, MAP_KEY_BYTES, "map%d", slot);
+}
+
+MapStore::MapStore(KVStore &store, ProfilingBlockDevice &device)
+    : _store(store), _device(device), _encoder(callback(this, &MapStore::put)),
+      _decoder(callback(this, &MapStore::put_tile)), _ready(false), _writing(false), _size(0),
+      _tail(0), _handle(nullptr), _chunk_length(0), _error(MBED_SUCCESS), _map(nullptr),
+      _bad_tile(false) { }
+
+bool MapStore::init() {
+    int error = _store.init();
+    _ready = error == MBED_SUCCESS;
+    if (!_ready) fail(-1, error);
+    return _ready;
+}
+
+bool MapStore::fail(int slot, int error) {
+    LOG_WARN(LOG_MAPS_FAILED, slot, error);
+    return false;
+}
+
+void MapStore::encode(TileMap const &map) {
+    _size = 0;
+    _chunk_length = 0;
+    _encoder.begin(MAP_WIDTH, MAP_HEIGHT);
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) _encoder.tile(map.get(x, y));
+    }
+    _encoder.end();
+}
+
+// Encoder output: counted on the first pass, handed to the store in chunks on the second
+void MapStore::put(uint8_t byte) {
+    _size++;
+    _tail = (_tail >> 8) | ((uint32_t)byte << 24);
+    if (!_writing) return;
+
+    _chunk[_chunk_length++] = byte;
+    if (_chunk_length == MAP_STORE_CHUNK) {
+        if (_error == MBED_SUCCESS) _error = _store.set_add_data(_handle, _chunk, _chunk_length);
+        _chunk_length = 0;
+    }
+}
+
+// True if the key already holds an encoding of the size and CRC just counted
+bool MapStore::holds(char const *key) {
+    KVStore::info_t info;
+    if (_store.get_info(key, &info) != MBED_SUCCESS || info.size != _size) return false;
+
+    uint8_t crc[4];
+    size_t got;
+    if (_store.get(key, crc, 4, &got, _size - 4) != MBED_SUCCESS || got != 4) return false;
+    return (crc[0] | (crc[1] << 8) | (crc[2] << 16) | ((uint32_t)crc[3] << 24)) == _tail;
+}
+
+bool MapStore::save(int slot, TileMap const &map) {
+    if (!_ready || slot < 0 || slot >= MAP_SLOTS) return false;
+    uint32_t start = us_ticker_read();
+    char key[MAP_KEY_BYTES];
+    slot_key(slot, key);
+
+    _writing = false;
+    encode(map);
+    if (holds(key)) {
+        LOG_INFO(LOG_MAPS_UNCHANGED, slot);
+        return true;
+    }
+
+    int error = _store.set_start(&_handle, key, _size, 0);
+    if (error != MBED_SUCCESS) return fail(slot, error);
+    _writing = true;
+    _error = MBED_SUCCESS;
+    encode(map);
+    _writing = false;
+    if (_error == MBED_SUCCESS && _chunk_length > 0) _error = _store.set_add_data(_handle, _chunk, _chunk_length);
+    // a failed set_add_data has already dropped the record; the old value stays
+    if (_error == MBED_SUCCESS) _error = _store.set_finalize(_handle);
+    if (_error != MBED_SUCCESS) return fail(slot, _error);
+
+    LOG_INFO(LOG_MAPS_SAVE, slot, us_ticker_read() - start, _size);
+    report();
+    return true;
+}
+
+// Decoder output
+void MapStore::put_tile(int x, int y, uint8_t tile) {
+    if (!_map->set(x, y, tile)) _bad_tile = true;
+}
+
+bool MapStore::load(int slot, TileMap &map) {
+    if (!_ready || slot < 0 || slot >= MAP_SLOTS) return false;
+    uint32_t start = us_ticker_read();
+    char key[MAP_KEY_BYTES];
+    slot_key(slot, key);
+
+    KVStore::info_t info;
+    int error = _store.get_info(key, &info);
+    if (error == MBED_ERROR_ITEM_NOT_FOUND) return false;  // nothing saved there yet
+    if (error != MBED_SUCCESS) return fail(slot, error);
+
+    _map = &map;
+    _bad_tile = false;
+    map.clear();
+    _decoder.begin(MAP_WIDTH, MAP_HEIGHT);
+
+    MapDecoder::Status status = MapDecoder::MAP_MORE;
+    for (size_t offset = 0; offset < info.size && status == MapDecoder::MAP_MORE; offset += MAP_STORE_CHUNK) {
+        size_t want = info.size - offset < MAP_STORE_CHUNK ? info.size - offset : MAP_STORE_CHUNK;
+        size_t got;
+        error = _store.get(key, _chunk, want, &got, offset);
+        if (error != MBED_SUCCESS || got != want) return fail(slot, error);
+        for (size_t i = 0; i < want && status == MapDecoder::MAP_MORE; i++) status = _decoder.push(_chunk[i]);
+    }
+    if (status != MapDecoder::MAP_DONE || _bad_tile) return fail(slot, MBED_ERROR_INVALID_DATA_DETECTED);
+
+    LOG_INFO(LOG_MAPS_LOAD, slot, us_ticker_read() - start, info.size);
+    return true;
+}
+
+void MapStore::report() const {
+    LOG_INFO(LOG_MAPS_WEAR, (uint32_t)_device.get_program_count(), (uint32_t)_device.get_erase_count());
+}
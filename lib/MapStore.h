@@ -0,0 +1,85 @@
+#ifndef MAPSTORE_H
+#define MAPSTORE_H
+
+#include "mbed.h"
+#include "kvstore/KVStore.h"
+#include "blockdevice/ProfilingBlockDevice.h"
+#include "TileMap.h"
+#include "MapCodec.h"
+
+// Slots are named map0, map1, ... in the store
+#define MAP_SLOTS 4
+#define MAP_KEY_BYTES 8
+
+// Bytes moved between the store and the codec at a time
+#define MAP_STORE_CHUNK 32
+
+/** MapStore Class
+@brief Named map slots kept in flash, in the binary map format
+
+Each slot is one key in a KVStore, normally a TDBStore on the flash after
+the program. TDBStore appends records and only erases to reclaim space, which
+spreads wear over its area, and a key's new value only replaces the old one
+once it is wholly written, so losing power during a save leaves the slot as
+it was. On top of that save() works out the new encoding's size and CRC
+first and writes nothing if the slot already holds it.
+
+Maps go through MapEncoder and MapDecoder MAP_STORE_CHUNK bytes at a time,
+so neither a save nor a load needs the whole encoding in RAM. The device
+under the store is passed in through a ProfilingBlockDevice so each save can
+log the flash programmed and erased since boot; loads and saves log how long
+they took. On the host a FileBlockDevice stands in for the flash.
+
+Example:
+
+@code
+
+FlashIAPBlockDevice flash;
+ProfilingBlockDevice wear(&flash);
+TDBStore store(&wear);
+MapStore maps(store, wear);
+
+maps.init();
+maps.save(0, map);
+...
+if (!maps.load(0, map)) map.clear();   // a failed load leaves map part-written
+
+@endcode
+*/
+class MapStore
+{
+public:
+    MapStore(KVStore &store, ProfilingBlockDevice &device);
+
+    bool init();                              // false if the store can't be mounted
+    bool save(int slot, TileMap const &map);
+    bool load(int slot, TileMap &map);        // false if empty, unreadable or not a map
+    void report() const;                      // flash wear since boot, to the log
+
+private:
+    void encode(TileMap const &map);
+    void put(uint8_t byte);
+    void put_tile(int x, int y, uint8_t tile);
+    bool holds(char const *key);
+    bool fail(int slot, int error);
+
+    KVStore &_store;
+    ProfilingBlockDevice &_device;
+    MapEncoder _encoder;
+    MapDecoder _decoder;
+    bool _ready;
+
+    // encoding: counted first, then written
+    bool _writing;
+    size_t _size;
+    uint32_t _tail;                          // the last four bytes, so the CRC
+    KVStore::set_handle_t _handle;
+    uint8_t _chunk[MAP_STORE_CHUNK];
+    int _chunk_length;
+    int _error;
+
+    TileMap *_map;                           // being loaded
+    bool _bad_tile;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include "MoveCurve.h"
+
+//                                  C   N  NE   E  SE   S  SW   W  NW
+const int8_t DIRECTION_DX[9] = {    0,  0,  1,  1,  1,  0, -1, -1, -1 };
+const int8_t DIRECTION_DY[9] = {    0, -1, -1,  0,  1,  1,  1,  0, -1 };
+
+// Speed in Q8 tiles per frame for each ramp row and magnitude. The magnitude
+// response is quadratic so small pushes give fine control; each row scales the
+// base curve (x1, x1.25, x1.5, x2, x2.5, x3, x4 and x8 for fast travel).
+static const uint16_t MOVE_CURVE[MOVE_ROWS][16] = {
+    {   0,    0,    8,    8,    9,   14,   20,   28,   36,   46,   57,   69,   82,   96,  112,  128},
+    {   0,    0,    8,    8,   11,   18,   26,   35,   46,   58,   71,   86,  102,  120,  139,  160},
+    {   0,    0,    8,    8,   14,   21,   31,   42,   55,   69,   85,  103,  123,  144,  167,  192},
+    {   0,    0,    8,   10,   18,   28,   41,   56,   73,   92,  114,  138,  164,  192,  223,  256},
+    {   0,    0,    8,   13,   23,   36,   51,   70,   91,  115,  142,  172,  205,  240,  279,  320},
+    {   0,    0,    8,   15,   27,   43,   61,   84,  109,  138,  171,  207,  246,  288,  335,  384},
+    {   0,    0,    9,   20,   36,   57,   82,  112,  146,  184,  228,  275,  328,  385,  446,  512},
+    {   0,    0,   18,   41,   73,  114,  164,  223,  291,  369,  455,  551,  655,  769,  892, 1024},
+};
+
+// Ramp row for each frame count held - a row per frame, then fast travel after
+// a further half second at the top of the ramp (10 frames per second)
+#define RAMP_FRAMES 16
+static const uint8_t RAMP_ROW[RAMP_FRAMES] = {
+    0, 0, 1, 2, 3, 4, 5, 6, 6, 6, 6, 6, 7, 7, 7, 7
+};
+
+MoveAxis::MoveAxis() { reset(); }
+
+void MoveAxis::reset() {
+    _acc = 0;
+    _dir = 0;
+    _held = 0;
+    _row = 0;
+}
+
+// Moves the ramp on by a frame and returns the unsigned Q8 speed
+int MoveAxis::advance(int dir, int mag, int maxRow) {
+    if (dir == 0 || mag <= 0) {
+        reset();
+        return 0;
+    }
+    if (dir != _dir) {
+        // new push - start just short of a tile so step() moves at once
+        _dir = dir;
+        _held = 0;
+        _acc = MOVE_ONE_TILE - 1;
+    } else if (_held < RAMP_FRAMES - 1) {
+        _held++;
+    }
+
+    _row = RAMP_ROW[_held];
+    if (_row > maxRow) _row = maxRow;
+    if (mag > 15) mag = 15;
+    return MOVE_CURVE[_row][mag];
+}
+
+int MoveAxis::step(int dir, int mag, int maxRow) {
+    _acc += advance(dir, mag, maxRow);
+    int tiles = _acc >> 8;
+    _acc &= MOVE_ONE_TILE - 1;
+    return _dir > 0 ? tiles : -tiles;
+}
+
+int MoveAxis::speed(int dir, int mag, int maxRow) {
+    int v = advance(dir, mag, maxRow);
+    return _dir > 0 ? v : -v;
+}
+
+bool MoveAxis::fast() const { return _row == MOVE_ROW_FAST; }
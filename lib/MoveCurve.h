@@ -0,0 +1,62 @@
+#ifndef MOVECURVE_H
+#define MOVECURVE_H
+
+#include <stdint.h>
+#include "Utils.h"
+
+// speeds are Q8 fixed point tiles per frame - 256 is one tile per frame
+#define MOVE_ONE_TILE 256
+
+// rows of MOVE_CURVE - the ramp climbs a row for each frame the stick is held
+#define MOVE_ROW_WALK  3   // cap for the explorer - never more than a tile per frame
+#define MOVE_ROW_RAMP  6   // top of the normal ramp (x4)
+#define MOVE_ROW_FAST  7   // fast travel (x8), reached by holding the stick past the ramp
+#define MOVE_ROWS      8
+
+// x and y components of each Direction (y down, as on the screen)
+extern const int8_t DIRECTION_DX[9];
+extern const int8_t DIRECTION_DY[9];
+
+/**
+ * @brief Sub-tile movement along one axis driven by joystick magnitude.
+ *
+ * Velocity is looked up in a precomputed curve table indexed by how long the
+ * stick has been held (the ramp row) and by the quantised magnitude from
+ * InputFrame, so a frame costs a couple of table reads and an add. A fresh push
+ * always moves one tile straight away so single taps stay precise.
+ */
+class MoveAxis {
+public:
+    MoveAxis();
+
+    /// Forget any movement in progress.
+    void reset();
+
+    /**
+     * @brief Advance one frame.
+     * @param dir -1, 0 or +1 along this axis.
+     * @param mag Quantised magnitude (0 to 15).
+     * @param maxRow Highest MOVE_CURVE row this caller allows.
+     * @return Whole tiles to move this frame (signed).
+     */
+    int step(int dir, int mag, int maxRow);
+
+    /**
+     * @brief Advance one frame, for callers that keep their own sub-tile position.
+     * @return Signed speed in Q8 tiles per frame, without the tap's first-frame tile.
+     */
+    int speed(int dir, int mag, int maxRow);
+
+    /// True once the ramp has reached fast travel.
+    bool fast() const;
+
+private:
+    int advance(int dir, int mag, int maxRow);
+
+    int _acc;       // Q8 distance travelled towards the next tile
+    int _dir;       // direction of the current push
+    uint8_t _held;  // frames the push has lasted (saturating)
+    uint8_t _row;   // MOVE_CURVE row used on the last step
+};
+
+#endif
@@ -1,10 +1,11 @@
 #include "Paddle.h"
+#include "Log.h"
 
 // nothing doing in the constructor and destructor
 Paddle::Paddle() { }
 
 void Paddle::init(int x,int height,int width) {
-    printf("Paddle: Init\n");
+    LOG_DEBUG(LOG_PADDLE_INIT);
     _x = x;  // x value on screen is fixed
     _y = HEIGHT/2 - height/2;  // y depends on height of screen and height of paddle
     _height = height;
@@ -14,12 +15,12 @@ void Paddle::init(int x,int height,int width) {
 }
 
 void Paddle::draw(N5110 &lcd) { 
-    printf("Paddle: Draw\n");
+    LOG_TRACE(LOG_PADDLE_DRAW);
     lcd.drawRect(_x,_y,_width,_height,FILL_BLACK); 
 }
 
 void Paddle::update(UserInput input) {
-    printf("Paddle: Update\n");
+    LOG_TRACE(LOG_PADDLE_UPDATE);
     _speed = 2;
     // update y value depending on direction of movement
     // North is decrement as origin is at the top-left so decreasing moves up
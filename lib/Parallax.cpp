@@ -0,0 +1,48 @@
+#include "Parallax.h"
+
+Parallax::Parallax() : _layers(nullptr), _count(0), _valid(false) {
+    memset(_banks, 0, sizeof(_banks));
+}
+
+void Parallax::init(ParallaxLayer const *layers, int count) {
+    if (count > PARALLAX_LAYERS) error("Parallax: %d layers, room for %d\n", count, PARALLAX_LAYERS);
+    _layers = layers;
+    _count = count;
+    _valid = false;
+}
+
+bool Parallax::scroll(int32_t x, int32_t y) {
+    bool moved = !_valid;
+    for (int i = 0; i < _count; i++) {
+        ParallaxLayer const &layer = _layers[i];
+        int32_t ox = (x * layer.rate_x) >> 8;
+        int32_t oy = (y * layer.rate_y) >> 8;
+        moved |= ox != _offset_x[i] || oy != _offset_y[i];
+        _offset_x[i] = ox;
+        _offset_y[i] = oy;
+    }
+    _valid = true;
+    if (moved) compose();
+    return moved;
+}
+
+// OR each layer's column words together, the rotation wrapping rows round
+void Parallax::compose() {
+    for (int x = 0; x < WIDTH; x++) {
+        uint64_t column = 0;
+        for (int i = 0; i < _count; i++) {
+            ParallaxLayer const &layer = _layers[i];
+            uint64_t word = layer.columns[(x + _offset_x[i]) & (layer.width - 1)];
+            int shift = ((_offset_y[i] % HEIGHT) + HEIGHT) % HEIGHT;
+            if (shift) word = ((word << shift) | (word >> (HEIGHT - shift))) & PARALLAX_COLUMN_BITS;
+            column |= word;
+        }
+        for (int bank = 0; bank < BANKS; bank++) _banks[bank][x] = column >> (bank * 8);
+    }
+}
+
+void Parallax::draw(N5110 &lcd, int first, int columns) const {
+    for (int bank = 0; bank < BANKS; bank++) {
+        lcd.blitBank(first, bank, &_banks[bank][first], columns);
+    }
+}
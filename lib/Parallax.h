@@ -0,0 +1,122 @@
+#ifndef PARALLAX_H
+#define PARALLAX_H
+
+#include "mbed.h"
+#include "N5110.h"
+
+// Most layers one Parallax composes
+#define PARALLAX_LAYERS 4
+
+// A column of the screen as one word, bit y for pixel row y
+#define PARALLAX_COLUMN_BITS ((1ull << HEIGHT) - 1)
+
+/// A pre-rendered layer, COLUMNS wide (a power of two) and a screen tall,
+/// made at compile time by the *_strip() functions below so it sits in flash
+template <int COLUMNS>
+struct ParallaxStrip {
+    static_assert((COLUMNS & (COLUMNS - 1)) == 0, "strips wrap by masking the column");
+    uint64_t columns[COLUMNS];
+};
+
+/// One layer of a Parallax: a strip and how fast it moves against the camera
+struct ParallaxLayer {
+    uint64_t const *columns;
+    uint16_t width;     // columns in the strip
+    int16_t rate_x;     // Q8: 256 moves a pixel per pixel the camera moves
+    int16_t rate_y;
+};
+
+#define PARALLAX_LAYER(strip, rate_x, rate_y) \
+    { (strip).columns, sizeof((strip).columns) / sizeof(uint64_t), (rate_x), (rate_y) }
+
+constexpr uint32_t parallax_hash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/// Single-pixel stars, one in a column with chance density/256, between rows top and bottom
+template <int COLUMNS>
+constexpr ParallaxStrip<COLUMNS> star_strip(uint32_t seed, int density, int top, int bottom) {
+    ParallaxStrip<COLUMNS> strip{};
+    for (int x = 0; x < COLUMNS; x++) {
+        uint32_t h = parallax_hash(seed ^ (uint32_t)x * 0x9E3779B9u);
+        if ((int)(h & 0xFF) < density) strip.columns[x] = 1ull << (top + (h >> 8) % (bottom - top + 1));
+    }
+    return strip;
+}
+
+/// A skyline a pixel thick, through a random height between rows top and bottom
+/// every `span` columns, joined up and wrapping round seamlessly
+template <int COLUMNS>
+constexpr ParallaxStrip<COLUMNS> ridge_strip(uint32_t seed, int span, int top, int bottom) {
+    ParallaxStrip<COLUMNS> strip{};
+    int peaks = COLUMNS / span;
+    int previous = -1;
+    for (int x = 0; x <= COLUMNS; x++) {
+        int peak = x / span % peaks, along = x % span;
+        int a = top + parallax_hash(seed + peak) % (bottom - top + 1);
+        int b = top + parallax_hash(seed + (peak + 1) % peaks) % (bottom - top + 1);
+        int y = a + (b - a) * along / span;
+        if (previous >= 0) {
+            // fill between this height and the last so steep slopes stay joined
+            int from = previous < y ? previous : y, to = previous < y ? y : previous;
+            uint64_t column = 0;
+            for (int row = from; row <= to; row++) column |= 1ull << row;
+            strip.columns[(x - 1) % COLUMNS] |= column;
+        }
+        previous = y;
+    }
+    return strip;
+}
+
+/** Parallax Class
+@brief Layered scrolling backgrounds, composed once and copied each frame
+
+Each layer is a strip of whole-column words in flash. Scrolling across picks
+a different column, and scrolling up or down rotates the word: both are one
+operation per column, never per pixel. scroll() works out every layer's
+offset from the camera. If none has moved a whole pixel the composite stays
+as it is; otherwise every column is recomposed. draw() copies the composite
+in bank by bank, which replaces clearing the screen, so it is always the
+whole range asked for: the game draws over the screen buffer every frame,
+so a column whose sky didn't move still has to be put back.
+
+Example:
+
+@code
+
+static constexpr ParallaxStrip<64> STARS = star_strip<64>(7, 60, 0, 47);
+static const ParallaxLayer LAYERS[] = { PARALLAX_LAYER(STARS, 32, 0) };
+
+sky.init(LAYERS, 1);
+...
+sky.scroll(camera_x, 0);
+sky.draw(lcd, 0, WIDTH);
+
+@endcode
+*/
+class Parallax
+{
+public:
+    Parallax();
+
+    void init(ParallaxLayer const *layers, int count);
+    bool scroll(int32_t x, int32_t y);                // the camera, in pixels; true if a layer moved
+    void draw(N5110 &lcd, int first, int columns) const;
+
+private:
+    void compose();
+
+    ParallaxLayer const *_layers;
+    int _count;
+    int32_t _offset_x[PARALLAX_LAYERS];
+    int32_t _offset_y[PARALLAX_LAYERS];
+    bool _valid;
+    uint8_t _banks[BANKS][WIDTH];  // the composite, in the screen buffer's bank order
+};
+
+#endif
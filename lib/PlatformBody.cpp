@@ -0,0 +1,138 @@
+#include "PlatformBody.h"
+#include "TileAtlas.h"
+
+static_assert(TILE_SIZE == 8, "tile_of() shifts by 3");
+
+// Fixed point pixels to the tile they fall in, rounding down for negatives too
+static int tile_of(fixed_t v) {
+    return v >> (FIXED_SHIFT + 3);
+}
+
+static fixed_t tile_edge(int tile) {
+    return (fixed_t)tile * TILE_SIZE << FIXED_SHIFT;
+}
+
+PlatformBody::PlatformBody(int width, int height) : _width(width), _height(height) {
+    place(0, 0);
+}
+
+void PlatformBody::place(int x, int y) {
+    _x = (fixed_t)x << FIXED_SHIFT;
+    _y = (fixed_t)y << FIXED_SHIFT;
+    _vy = 0;
+    _on_ground = false;
+    _jumping = false;
+    _jump_timer = 0;
+    _coyote_timer = 0;
+}
+
+int PlatformBody::x() const { return _x >> FIXED_SHIFT; }
+int PlatformBody::y() const { return _y >> FIXED_SHIFT; }
+int PlatformBody::tile_x() const { return tile_of(_x + (_width << FIXED_SHIFT) / 2); }
+int PlatformBody::tile_y() const { return tile_of(_y + (_height << FIXED_SHIFT) - 1); }
+bool PlatformBody::on_ground() const { return _on_ground; }
+fixed_t PlatformBody::speed_y() const { return _vy; }
+
+// Any solid tile in this column over the rows the box covers?
+bool PlatformBody::blocked_column(TileWorld &world, int column) const {
+    int bottom = tile_of(_y + (_height << FIXED_SHIFT) - 1);
+    for (int row = tile_of(_y); row <= bottom; row++) {
+        if (world.solid(column, row)) return true;
+    }
+    return false;
+}
+
+bool PlatformBody::blocked_row(TileWorld &world, int row) const {
+    int right = tile_of(_x + (_width << FIXED_SHIFT) - 1);
+    for (int column = tile_of(_x); column <= right; column++) {
+        if (world.solid(column, row)) return true;
+    }
+    return false;
+}
+
+// Sweep the leading edge across each tile boundary; true if it hit something
+bool PlatformBody::move_x(TileWorld &world, fixed_t dx) {
+    if (dx > 0) {
+        fixed_t edge = _x + (_width << FIXED_SHIFT) - 1;
+        for (int column = tile_of(edge) + 1; column <= tile_of(edge + dx); column++) {
+            if (blocked_column(world, column)) {
+                _x = tile_edge(column) - (_width << FIXED_SHIFT);
+                return true;
+            }
+        }
+    } else if (dx < 0) {
+        for (int column = tile_of(_x) - 1; column >= tile_of(_x + dx); column--) {
+            if (blocked_column(world, column)) {
+                _x = tile_edge(column + 1);
+                return true;
+            }
+        }
+    }
+    _x += dx;
+    return false;
+}
+
+bool PlatformBody::move_y(TileWorld &world, fixed_t dy) {
+    if (dy > 0) {
+        fixed_t edge = _y + (_height << FIXED_SHIFT) - 1;
+        for (int row = tile_of(edge) + 1; row <= tile_of(edge + dy); row++) {
+            if (blocked_row(world, row)) {
+                _y = tile_edge(row) - (_height << FIXED_SHIFT);
+                return true;
+            }
+        }
+    } else if (dy < 0) {
+        for (int row = tile_of(_y) - 1; row >= tile_of(_y + dy); row--) {
+            if (blocked_row(world, row)) {
+                _y = tile_edge(row + 1);
+                return true;
+            }
+        }
+    }
+    _y += dy;
+    return false;
+}
+
+void PlatformBody::step(TileWorld &world, fixed_t walk_speed, bool jump_held,
+                        PlatformTuning const &tuning) {
+    _on_ground = blocked_row(world, tile_of(_y + (_height << FIXED_SHIFT)));
+
+    if (_on_ground) {
+        _coyote_timer = tuning.coyote_frames;
+    } else if (_coyote_timer > 0) {
+        _coyote_timer--;
+    }
+
+    if (!_jumping && _coyote_timer > 0 && jump_held) {
+        _jumping = true;
+        _jump_timer = tuning.jump_frames;
+        _coyote_timer = 0;  // one jump per take-off
+        _vy = tuning.jump_speed;
+    }
+
+    if (_jumping) {
+        if (_jump_timer > 0 && jump_held) {
+            _vy = tuning.jump_speed;
+            _jump_timer--;
+        } else {
+            _jumping = false;
+        }
+    }
+
+    if (!jump_held) {
+        _jumping = false;
+        _jump_timer = 0;
+    }
+
+    if (!_on_ground || _vy < 0) {
+        _vy += tuning.gravity;
+        if (_vy > tuning.max_fall) _vy = tuning.max_fall;
+    }
+
+    move_x(world, walk_speed);
+    if (move_y(world, _vy)) {
+        if (_vy > 0) _on_ground = true;  // landed this frame
+        _vy = 0;
+        _jumping = false;
+    }
+}
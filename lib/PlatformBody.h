@@ -0,0 +1,86 @@
+#ifndef PLATFORMBODY_H
+#define PLATFORMBODY_H
+
+#include "mbed.h"
+#include "TileWorld.h"
+
+// Positions and speeds are Q24.8 fixed point pixels: 256 is one pixel, and
+// a world half a million tiles wide still fits
+typedef int32_t fixed_t;
+#define FIXED_SHIFT 8
+#define FIXED_ONE (1 << FIXED_SHIFT)
+
+/// Jump feel, in fixed point pixels per frame (and per frame per frame)
+struct PlatformTuning {
+    fixed_t gravity;
+    fixed_t jump_speed;     // upward, so negative
+    fixed_t max_fall;
+    uint8_t jump_frames;    // frames the jump speed holds while the button does
+    uint8_t coyote_frames;  // frames after walking off a ledge that still allow a jump
+};
+
+/// How far the feet rise on a jump held for all its frames, worked through
+/// the same frames step() does: the jump speed less a frame's gravity while
+/// it holds, then gravity alone until the body stops rising
+constexpr fixed_t jump_height(PlatformTuning const &tuning) {
+    fixed_t vy = tuning.jump_speed + tuning.gravity;
+    fixed_t rise = -vy * (tuning.jump_frames > 0 ? tuning.jump_frames : 1);
+    for (vy += tuning.gravity; vy < 0; vy += tuning.gravity) rise -= vy;
+    return rise;
+}
+
+/** PlatformBody Class
+@brief A box that walks, jumps and falls through a TileWorld
+
+Integer-only: positions and speeds are fixed_t, with no rounding that could
+drift, so the same input always moves the body the same way and recorded
+sessions replay exactly.
+
+Each step moves along x, then along y, and each move is swept: every tile
+boundary the leading edge crosses is checked on the way, so even a fall of
+several tiles in one frame stops on the first solid row instead of
+tunnelling through it. A blocked move stops flush against the tile.
+
+Example:
+
+@code
+
+PlatformBody player(6, 8);
+player.place(17, 48);                    // top-left, in pixels
+...
+player.step(world, walk_speed, jump_held, TUNING);
+draw_at(player.x(), player.y());
+
+@endcode
+*/
+class PlatformBody
+{
+public:
+    PlatformBody(int width, int height);  // hitbox in pixels
+
+    void place(int x, int y);             // also stops all motion
+    void step(TileWorld &world, fixed_t walk_speed, bool jump_held, PlatformTuning const &tuning);
+
+    int x() const;                        // top-left, in pixels
+    int y() const;
+    int tile_x() const;                   // tile under the middle of the box
+    int tile_y() const;                   // tile the feet are in
+    bool on_ground() const;
+    fixed_t speed_y() const;
+
+private:
+    bool blocked_column(TileWorld &world, int column) const;
+    bool blocked_row(TileWorld &world, int row) const;
+    bool move_x(TileWorld &world, fixed_t dx);
+    bool move_y(TileWorld &world, fixed_t dy);
+
+    fixed_t _x, _y;
+    fixed_t _vy;
+    int _width, _height;
+    bool _on_ground;
+    bool _jumping;
+    int _jump_timer;
+    int _coyote_timer;
+};
+
+#endif
@@ -0,0 +1,114 @@
+#include "PowerMonitor.h"
+
+// energy in uJ used per minute at the given split of time between states
+static uint32_t energy_per_minute(uint64_t active, uint64_t sleep, uint64_t deep, uint64_t total) {
+    uint64_t ua = (active * MBED_CONF_APP_POWER_RUN_UA +
+                   sleep * MBED_CONF_APP_POWER_SLEEP_UA +
+                   deep * MBED_CONF_APP_POWER_DEEPSLEEP_UA) / total;
+    return (uint32_t)(ua * MBED_CONF_APP_POWER_SUPPLY_MV * 60 / 1000);  // uA * mV = nW
+}
+
+// hundredths of a percent of total
+static uint32_t basis_points(uint64_t part, uint64_t total) {
+    return (uint32_t)(part * 10000 / total);
+}
+
+// value / 10^decimals as text - minimal-printf has no precision or zero padding
+static char const *fixed(char *buf, uint32_t value, int decimals) {
+    uint32_t scale = 1;
+    for (int i = 0; i < decimals; i++) scale *= 10;
+    int n = sprintf(buf, "%u.", (unsigned)(value / scale));
+    uint32_t frac = value % scale;
+    for (int i = decimals - 1; i >= 0; i--) {
+        buf[n + i] = '0' + frac % 10;
+        frac /= 10;
+    }
+    buf[n + decimals] = '\0';
+    return buf;
+}
+
+PowerMonitor::PowerMonitor() : _frames(0), _redraws(0), _redraw_us(0) {
+    memset(&_start, 0, sizeof(_start));
+}
+
+void PowerMonitor::begin() {
+    mbed_stats_cpu_get(&_start);
+    _frames = 0;
+    _redraws = 0;
+    _redraw_us = 0;
+}
+
+void PowerMonitor::note_frame() { _frames++; }
+
+void PowerMonitor::note_redraw(uint32_t us) {
+    _redraws++;
+    _redraw_us += us;
+}
+
+uint32_t PowerMonitor::elapsed_s() const {
+    mbed_stats_cpu_t now;
+    mbed_stats_cpu_get(&now);
+    return (uint32_t)((now.uptime - _start.uptime) / 1000000);
+}
+
+void PowerMonitor::report(char const *name) {
+    mbed_stats_cpu_t now;
+    mbed_stats_cpu_get(&now);
+
+    // all in microseconds
+    uint64_t total = now.uptime - _start.uptime;
+    if (total == 0) return;
+    uint64_t deep = now.deep_sleep_time - _start.deep_sleep_time;
+    uint64_t sleep = now.sleep_time - _start.sleep_time;
+    uint64_t active = total > deep + sleep ? total - deep - sleep : 0;
+
+    uint32_t busy = basis_points(active, total);
+    uint32_t deep_bp = basis_points(deep, total);
+    uint32_t uj = energy_per_minute(active, sleep, deep, total);
+    char a[16], b[16], c[16];
+    printf("%s: %u s, CPU %s%% active, %s%% deep sleep, %s mJ/min\n",
+           name, (unsigned)(total / 1000000), fixed(a, busy, 2), fixed(b, deep_bp, 2), fixed(c, uj, 3));
+
+    // the same interval redrawing every tick and never deep sleeping
+    if (_redraws && _frames > _redraws) {
+        uint64_t base_active = active + _redraw_us * (_frames - _redraws) / _redraws;
+        if (base_active > total) base_active = total;
+        busy = basis_points(base_active, total);
+        uj = energy_per_minute(base_active, total - base_active, 0, total);
+        printf("%s: redrew %u of %u frames; redrawing every frame: CPU %s%% active, %s mJ/min\n",
+               name, (unsigned)_redraws, (unsigned)_frames, fixed(a, busy, 2), fixed(c, uj, 3));
+    }
+}
+
+
+IdleTimer::IdleTimer(int frames, Kernel::Clock::duration idle_period)
+    : _frames(frames), _quiet(0), _applied(false), _idle_period(idle_period), _active_period(idle_period) { }
+
+bool IdleTimer::tick(InputFrame const &in) {
+    bool was_idle = idle();
+    if (in.d != CENTRE || in.buttons) {
+        _quiet = 0;
+    } else if (_quiet < _frames) {
+        _quiet++;
+    }
+    return was_idle && !idle();
+}
+
+bool IdleTimer::idle() const { return _quiet >= _frames; }
+
+void IdleTimer::apply(N5110 &lcd, InputSource &input) {
+    bool sleepy = idle();
+    if (sleepy == _applied) return;
+    lcd.sleepBacklight(sleepy);
+    // buffered serial keeps its RX interrupt, and so a deep sleep lock, while
+    // input is enabled: an idle screen stops listening to the console
+    FileHandle *console = mbed_file_handle(STDIN_FILENO);
+    if (console) console->enable_input(!sleepy);
+    if (sleepy) {
+        _active_period = input.sample_period();
+        input.set_sample_period(_idle_period);
+    } else {
+        input.set_sample_period(_active_period);
+    }
+    _applied = sleepy;
+}
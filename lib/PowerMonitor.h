@@ -0,0 +1,70 @@
+#ifndef POWERMONITOR_H
+#define POWERMONITOR_H
+
+#include "mbed.h"
+#include "N5110.h"
+#include "InputSource.h"
+
+/** PowerMonitor Class
+@brief CPU duty cycle and estimated energy use over an interval
+
+Reads the kernel's CPU statistics (platform.cpu-stats-enabled) to split the
+interval into active, sleep and deep sleep time, and turns that into an energy
+estimate using the supply voltage and typical MCU currents from mbed_app.json.
+
+Screens that only redraw when something changes call note_frame() every tick
+and note_redraw() when they actually draw, which lets report() also estimate
+what the same interval would have cost redrawing every frame without deep sleep.
+*/
+class PowerMonitor
+{
+public:
+    PowerMonitor();
+
+    void begin();                    // start of the measured interval
+    void note_frame();               // a tick went by
+    void note_redraw(uint32_t us);   // a tick drew and refreshed the screen, taking us
+    void report(char const *name);   // print duty cycle and energy per minute since begin()
+    uint32_t elapsed_s() const;      // seconds since begin()
+
+private:
+    mbed_stats_cpu_t _start;
+    uint32_t _frames;
+    uint32_t _redraws;
+    uint64_t _redraw_us;
+};
+
+// How often an idle screen samples input
+#define IDLE_SAMPLE_PERIOD 100ms
+
+/**
+ * @brief Tracks how long a screen has gone without input.
+ *
+ * Once idle, apply() turns the backlight off, stops console input and slows
+ * the input thread to the idle period so the MCU can spend the time between
+ * ticks in deep sleep. Any input wakes it again, and the period the input
+ * thread had before is put back. Console bytes sent while idle are lost, so
+ * move the stick before sending a map.
+ */
+class IdleTimer {
+public:
+    IdleTimer(int frames, Kernel::Clock::duration idle_period = IDLE_SAMPLE_PERIOD);
+
+    /// Count one tick of input, returns true on the tick the screen wakes up.
+    bool tick(InputFrame const &in);
+
+    /// True once no input has been seen for the configured number of frames.
+    bool idle() const;
+
+    /// Put the backlight and input thread in the state matching idle().
+    void apply(N5110 &lcd, InputSource &input);
+
+private:
+    int _frames;
+    int _quiet;
+    bool _applied;
+    Kernel::Clock::duration _idle_period;
+    Kernel::Clock::duration _active_period;  // the input thread's, from before it was slowed
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "Profiler.h"
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__MBED__)
+#include "mbed.h"
+#include "N5110.h"
+#define PROFILER_CLOCK_HZ SystemCoreClock
+#else
+#include <chrono>
+#define PROFILER_CLOCK_HZ 1000000000u  // the host counts nanoseconds
+#endif
+
+struct ZoneStats {
+    uint32_t ring[PROFILE_RING];
+    uint32_t count;     // samples since reset
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t frame;     // cycles spent in this zone during the current frame
+};
+
+static ZoneStats zones[ZONE_COUNT];
+static const char *const ZONE_NAMES[ZONE_COUNT] = { "input", "update", "draw", "refresh", "flush" };
+
+static bool started = false;
+static bool overlay = false;
+static uint32_t last_frame = 0;
+static uint32_t frame_cycles = 0;   // period of the last frame
+static uint32_t work_cycles = 0;    // time spent in zones during the last frame
+
+static void start() {
+#if defined(__MBED__)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;  // enable the trace block
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    started = true;
+    Profiler::reset();
+}
+
+uint32_t Profiler::now() {
+    if (!started) start();
+#if defined(__MBED__)
+    return DWT->CYCCNT;
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static uint32_t to_us(uint64_t cycles) {
+    return (uint32_t)(cycles * 1000000u / PROFILER_CLOCK_HZ);
+}
+
+void Profiler::record(ProfileZone zone, uint32_t cycles) {
+    ZoneStats &z = zones[zone];
+    z.ring[z.count & (PROFILE_RING - 1)] = cycles;
+    z.count++;
+    z.total += cycles;
+    if (cycles < z.min) z.min = cycles;
+    if (cycles > z.max) z.max = cycles;
+    z.frame += cycles;
+}
+
+void Profiler::reset() {
+    memset(zones, 0, sizeof(zones));
+    for (int i = 0; i < ZONE_COUNT; i++) zones[i].min = UINT32_MAX;
+}
+
+void Profiler::set_overlay(bool on) { overlay = on; }
+
+// 99th percentile of the samples in the ring, by insertion sort of a copy
+static uint32_t percentile99(ZoneStats const &z) {
+    uint32_t n = z.count < PROFILE_RING ? z.count : PROFILE_RING;
+    if (n == 0) return 0;
+    uint32_t sorted[PROFILE_RING];
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t v = z.ring[i];
+        uint32_t j = i;
+        while (j > 0 && sorted[j - 1] > v) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = v;
+    }
+    return sorted[(n * 99 - 1) / 100];
+}
+
+void Profiler::dump() {
+    // minimal-printf has no field widths, so the table is tab separated
+    printf("zone\tmin\tavg\tmax\tp99 (us, last %u samples)\n", (unsigned)PROFILE_RING);
+    for (int i = 0; i < ZONE_COUNT; i++) {
+        ZoneStats const &z = zones[i];
+        if (z.count == 0) continue;
+        printf("%s\t%u\t%u\t%u\t%u\n", ZONE_NAMES[i],
+               (unsigned)to_us(z.min), (unsigned)to_us(z.total / z.count),
+               (unsigned)to_us(z.max), (unsigned)to_us(percentile99(z)));
+    }
+    uint32_t frame_us = to_us(frame_cycles);
+    printf("frame %u us (%u fps), work %u us\n", (unsigned)frame_us,
+           (unsigned)(frame_us ? 1000000 / frame_us : 0), (unsigned)to_us(work_cycles));
+}
+
+// SceneManager reads the console and passes on what the scene doesn't take
+void Profiler::command(char c) {
+    if (c == 'p') {
+        dump();
+        reset();
+    } else if (c == 'o') {
+        overlay = !overlay;
+    }
+}
+
+void Profiler::end_frame(N5110 &lcd) {
+    uint32_t t = now();
+    frame_cycles = t - last_frame;
+    last_frame = t;
+
+    work_cycles = 0;
+    for (int i = 0; i < ZONE_COUNT; i++) {
+        if (i != ZONE_FLUSH) work_cycles += zones[i].frame;  // flush runs on the display thread
+        zones[i].frame = 0;
+    }
+
+#if defined(__MBED__)
+    if (overlay) {
+        char buf[15];
+        uint32_t frame_us = to_us(frame_cycles);
+        sprintf(buf, "%uf %ums", (unsigned)(frame_us ? 1000000 / frame_us : 0),
+                (unsigned)(to_us(work_cycles) / 1000));
+        int x = WIDTH - 6 * (int)strlen(buf);
+        lcd.drawRect(x - 1, 39, WIDTH - x + 1, 9, FILL_WHITE);
+        lcd.printString(buf, x, 5);
+    }
+#endif
+}
@@ -0,0 +1,84 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+// Turned on with the app.profiler option in mbed_app.json
+#ifndef MBED_CONF_APP_PROFILER
+#define MBED_CONF_APP_PROFILER 0
+#endif
+
+class N5110;
+
+/// Phases of a frame that are timed
+enum ProfileZone {
+    ZONE_INPUT,    // sampling input
+    ZONE_UPDATE,   // simulation
+    ZONE_DRAW,     // rasterising into the screen buffer
+    ZONE_REFRESH,  // lcd.refresh() - the SPI send, or the hand-off when pipelined
+    ZONE_FLUSH,    // SPI send on the display thread when pipelined
+    ZONE_COUNT
+};
+
+// samples kept per zone for the percentile - a power of two
+#define PROFILE_RING 128
+
+/** Profiler
+@brief Per-phase frame timing from the Cortex-M DWT cycle counter
+
+Wrap each phase of a frame in PROFILE_ZONE() and call PROFILE_FRAME() once the
+frame is drawn, just before lcd.refresh(). Each zone keeps min/avg/max since the
+last dump and a ring of recent samples for the 99th percentile. On the host the
+cycle counter is replaced by std::chrono::steady_clock.
+
+Over the serial console, 'p' dumps the table and 'o' toggles an FPS / frame ms
+overlay in the bottom-right corner of the screen.
+
+With app.profiler set to 0 the macros expand to nothing, so there is no cost.
+
+Example:
+
+@code
+
+{ PROFILE_ZONE(ZONE_UPDATE); update(); }
+{ PROFILE_ZONE(ZONE_DRAW); draw(lcd); }
+PROFILE_FRAME(lcd);
+{ PROFILE_ZONE(ZONE_REFRESH); lcd.refresh(); }
+
+@endcode
+*/
+class Profiler
+{
+public:
+    static uint32_t now();                       // cycle count (or ns on the host)
+    static void record(ProfileZone zone, uint32_t cycles);
+    static void end_frame(N5110 &lcd);           // frame rate and overlay
+    static void command(char c);                 // console key: 'p' dumps, 'o' toggles the overlay
+    static void dump();                          // print the zone table over serial
+    static void reset();
+    static void set_overlay(bool on);
+};
+
+/// Times from construction to the end of the enclosing scope
+class ScopedZone
+{
+public:
+    ScopedZone(ProfileZone zone) : _zone(zone), _start(Profiler::now()) { }
+    ~ScopedZone() { Profiler::record(_zone, Profiler::now() - _start); }
+
+private:
+    ProfileZone _zone;
+    uint32_t _start;
+};
+
+#if MBED_CONF_APP_PROFILER
+#define PROFILE_ZONE(zone) ScopedZone _profile_zone(zone)
+#define PROFILE_FRAME(lcd) Profiler::end_frame(lcd)
+#define PROFILE_COMMAND(c) Profiler::command(c)
+#else
+#define PROFILE_ZONE(zone) do { } while (0)
+#define PROFILE_FRAME(lcd) do { } while (0)
+#define PROFILE_COMMAND(c) do { } while (0)
+#endif
+
+#endif
@@ -0,0 +1,26 @@
+#include "Random.h"
+
+Random::Random(uint32_t seed) { this->seed(seed); }
+
+void Random::seed(uint32_t seed) {
+    // xorshift has a fixed point at zero, so never let the state get stuck there
+    _state = seed ? seed : 0x9E3779B9u;
+}
+
+// Marsaglia xorshift32 - three shifts and xors, period 2^32 - 1
+uint32_t Random::next() {
+    uint32_t x = _state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _state = x;
+    return x;
+}
+
+int Random::range(int n) {
+    if (n <= 0) return 0;
+    // multiply-shift keeps the top bits, which are better mixed than the low ones
+    return (int)(((uint64_t)next() * (uint32_t)n) >> 32);
+}
+
+uint32_t Random::get_state() const { return _state; }
@@ -0,0 +1,36 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/** Random Class
+@brief Small seedable xorshift32 pseudo-random generator
+
+Used instead of rand() so that a game seeded with the same value always gets
+the same sequence, whatever the C library. This is what lets a recorded input
+session (see InputRecorder) be replayed with identical results.
+
+Example:
+
+@code
+
+Random rng(1234);
+int lane = rng.range(3) + 1;   // 1 to 3
+
+@endcode
+*/
+class Random
+{
+public:
+    Random(uint32_t seed = 1);
+
+    void seed(uint32_t seed);     // restart the sequence (a zero seed is remapped)
+    uint32_t next();              // next 32-bit value
+    int range(int n);             // value in the range 0 to n-1
+    uint32_t get_state() const;   // current state, e.g. to save and restore
+
+private:
+    uint32_t _state;
+};
+
+#endif
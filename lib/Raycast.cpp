@@ -0,0 +1,33 @@
+#include "Raycast.h"
+
+bool raycast(TileWorld &world, int x0, int y0, int x1, int y1, int *hit_x, int *hit_y) {
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    int step_x = x1 > x0 ? 1 : -1;
+    int step_y = y1 > y0 ? 1 : -1;
+    int x = x0, y = y0;
+
+    // error tracks which tile edge the line crosses next; on a corner it
+    // goes vertically first, so diagonal gaps are still checked
+    int error = dx - dy;
+    for (int n = dx + dy; n > 0; n--) {
+        if (error > 0) {
+            x += step_x;
+            error -= 2 * dy;
+        } else {
+            y += step_y;
+            error += 2 * dx;
+        }
+        if (world.solid(x, y)) {
+            if (hit_x) *hit_x = x;
+            if (hit_y) *hit_y = y;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool line_of_sight(TileWorld &world, int x0, int y0, int x1, int y1) {
+    int hx, hy;
+    return !raycast(world, x0, y0, x1, y1, &hx, &hy) || (hx == x1 && hy == y1);
+}
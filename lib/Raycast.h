@@ -0,0 +1,25 @@
+#ifndef RAYCAST_H
+#define RAYCAST_H
+
+#include "mbed.h"
+#include "TileWorld.h"
+
+/*
+ * Grid rays between tile centres, stepping tile by tile with integer DDA:
+ * every tile the line passes through is visited once, with no gaps at
+ * diagonals, so a ray can't slip between two solid tiles that touch at a
+ * corner. There is no floating point, so a ray's tiles depend only on its
+ * two end points.
+ */
+
+/**
+ * @brief Follow a ray from (x0,y0) towards (x1,y1), not counting the start tile.
+ * @param hit_x, hit_y Set to the first solid tile on the way, if there is one.
+ * @return true if a solid tile was found at or before (x1,y1).
+ */
+bool raycast(TileWorld &world, int x0, int y0, int x1, int y1, int *hit_x, int *hit_y);
+
+/// True if nothing solid lies strictly between the two tiles (the end tile may be solid)
+bool line_of_sight(TileWorld &world, int x0, int y0, int x1, int y1);
+
+#endif
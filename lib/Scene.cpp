@@ -0,0 +1,22 @@
+#include "Scene.h"
+#include "SceneManager.h"
+
+Scene::Scene(char const *name) : _name(name), _manager(nullptr) { }
+
+char const *Scene::name() const { return _name; }
+
+void Scene::change(SceneId next) {
+    if (_manager) _manager->change(next);
+}
+
+void Scene::preload_scene(SceneId id) {
+    if (_manager) _manager->preload(id);
+}
+
+bool Scene::quality(QualityFeature feature) const {
+    return !_manager || _manager->governor().enabled(feature);
+}
+
+Arena &Scene::arena() {
+    return _manager->arena();
+}
@@ -0,0 +1,81 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include "mbed.h"
+#include "N5110.h"
+#include "Utils.h"
+#include "FrameGovernor.h"
+#include "Arena.h"
+
+class SceneManager;
+
+/// Folds one more value into a Scene::state() hash (FNV-1a step)
+inline uint32_t state_mix(uint32_t hash, uint32_t value) { return (hash ^ value) * 16777619u; }
+
+/// Every screen the SceneManager can switch between
+enum SceneId {
+    SCENE_MENU,
+    SCENE_EXPLORE,
+    SCENE_INVADERS,
+    SCENE_EDITOR,
+    SCENE_EXIT,
+    SCENE_COUNT,
+    SCENE_NONE = SCENE_COUNT
+};
+
+/** Scene Class
+@brief One screen of the game, driven a tick at a time by the SceneManager
+
+A scene never blocks or sleeps: splash screens, banners and the like are
+states that count down in update(). To leave, a scene calls change() and the
+manager switches at the end of the current tick.
+
+preload() is called ahead of time, e.g. while the menu highlights the scene,
+so that enter() only has to reset state and the switch fits inside a frame.
+It must be safe to call more than once.
+
+Level and entity data that lasts as long as the scene is allocated from
+arena() in enter(). The arena is emptied after exit(), so there is nothing to
+free, and it must not be used from preload() - another scene still owns it.
+
+Scenes that redraw only when something changes override dirty() to return
+false when their last drawn frame is still current. Optional work such as
+particles should be skipped when quality() says the frame budget is tight.
+
+Scenes that record or replay input sessions override state() to return a
+hash of what update() has worked out, built with state_mix(), so a replay can
+be checked against its recording. It must leave out anything the governor or
+drawing changes.
+*/
+class Scene
+{
+public:
+    Scene(char const *name);
+    virtual ~Scene() { }
+
+    char const *name() const;
+
+    virtual void preload() { }
+    virtual void enter() { }
+    virtual void update(InputFrame const &in, uint8_t pressed) = 0;  // pressed = buttons that went down this tick
+    virtual void draw(N5110 &lcd) = 0;
+    virtual void exit() { }
+
+    virtual bool console(uint8_t byte) { return false; }               // a byte typed on the console, true if taken
+    virtual bool dirty() const { return true; }                        // draw this frame
+    virtual uint32_t state() const { return 0; }                       // hash of the simulation, after update()
+    virtual Kernel::Clock::duration tick() const { return 100ms; }    // simulation tick
+
+protected:
+    void change(SceneId next);          // switch once this tick is over
+    void preload_scene(SceneId id);     // get another scene's assets ready
+    bool quality(QualityFeature feature) const;  // optional work the governor still allows
+    Arena &arena();                     // memory for this visit, emptied on exit
+
+private:
+    friend class SceneManager;
+    char const *_name;
+    SceneManager *_manager;
+};
+
+#endif
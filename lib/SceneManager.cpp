@@ -0,0 +1,141 @@
+#include "SceneManager.h"
+#include "Profiler.h"
+#include "hal/us_ticker_api.h"
+
+// Share of the tick a frame may take before the governor steps in, 0 to turn it off
+#ifndef MBED_CONF_APP_FRAME_BUDGET_PCT
+#define MBED_CONF_APP_FRAME_BUDGET_PCT 80
+#endif
+
+SceneManager::SceneManager(N5110 &lcd, InputSource &input, FramePipeline *pipeline)
+    : _lcd(lcd), _input(input), _pipeline(pipeline), _current(nullptr), _next(SCENE_NONE),
+      _buttons(0), _loop(100ms), _idle(MBED_CONF_APP_IDLE_BACKLIGHT_FRAMES),
+      _arena(_memory, sizeof(_memory), "Scene") {
+    for (int i = 0; i < SCENE_COUNT; i++) _scenes[i] = nullptr;
+}
+
+void SceneManager::add(SceneId id, Scene &scene) {
+    _scenes[id] = &scene;
+    scene._manager = this;
+}
+
+void SceneManager::change(SceneId next) {
+    if (_scenes[next]) _next = next;
+}
+
+void SceneManager::preload(SceneId id) {
+    if (_scenes[id]) _scenes[id]->preload();
+}
+
+FrameGovernor const &SceneManager::governor() const { return _governor; }
+
+Arena &SceneManager::arena() { return _arena; }
+
+void SceneManager::set_tick(Kernel::Clock::duration tick) {
+    _loop.set_tick(tick);
+    uint32_t tick_us = std::chrono::duration_cast<std::chrono::microseconds>(tick).count();
+    _governor.set_budget(tick_us * MBED_CONF_APP_FRAME_BUDGET_PCT / 100);
+}
+
+void SceneManager::run(SceneId first) {
+    _current = _scenes[first];
+    _current->preload();
+    _current->enter();
+    set_tick(_current->tick());
+    _power.begin();
+    _loop.start();
+
+    bool redraw = true;  // the scene's first frame, or the screen waking up
+    while (true) {
+        int updates = _loop.wait();
+        uint32_t frame_start = us_ticker_read();
+        read_console();
+        for (int i = 0; i < updates && _next == SCENE_NONE; i++) {
+            InputFrame in;
+            { PROFILE_ZONE(ZONE_INPUT); in = _input.sample(); }
+            uint8_t pressed = in.buttons & ~_buttons;
+            _buttons = in.buttons;
+            { PROFILE_ZONE(ZONE_UPDATE); _current->update(in, pressed); }
+            _input.hash_state(_current->state());
+            if (_idle.tick(in)) redraw = true;
+            _power.note_frame();
+        }
+
+        if (_next != SCENE_NONE) {
+            switch_scene();
+            redraw = true;
+        }
+        // games speed up by shortening their tick
+        if (_current->tick() != _loop.get_tick()) set_tick(_current->tick());
+
+        // Nothing changed - go back to sleep until the next tick
+        if (MBED_CONF_APP_RENDER_ON_CHANGE) {
+            _idle.apply(_lcd, _input);
+            if (!redraw && !_current->dirty()) continue;
+        }
+
+        uint32_t start = us_ticker_read();
+        { PROFILE_ZONE(ZONE_DRAW); _current->draw(_lcd); }
+        PROFILE_FRAME(_lcd);
+        { PROFILE_ZONE(ZONE_REFRESH); _lcd.refresh(); }
+        uint32_t end = us_ticker_read();
+        _power.note_redraw(end - start);
+        redraw = false;
+
+        _governor.frame(end - frame_start);
+        _lcd.setPartialFlush(!_governor.enabled(QUALITY_FULL_FLUSH));
+
+        // Report once a minute so long sessions can be compared
+        if (_power.elapsed_s() >= 60) {
+            _power.report(_current->name());
+            _power.begin();
+        }
+    }
+}
+
+// The one reader of the console, so a map import and profiler keys can't eat
+// each other's bytes: the scene gets first refusal, the profiler the rest
+void SceneManager::read_console() {
+    FileHandle *console = mbed_file_handle(STDIN_FILENO);
+    uint8_t c;
+    while (console && console->readable() && console->read(&c, 1) == 1) {
+        if (!_current->console(c)) PROFILE_COMMAND(c);
+    }
+}
+
+void SceneManager::switch_scene() {
+    Scene *previous = _current;
+    Scene *next = _scenes[_next];
+    _next = SCENE_NONE;
+
+    uint32_t start = us_ticker_read();
+    previous->exit();
+    size_t arena_high = _arena.high_water();
+    _arena.reset();
+    _arena.reset_high_water();
+    next->preload();  // normally done already, then this is a no-op
+    next->enter();
+    _current = next;
+    uint32_t took = us_ticker_read() - start;
+
+    // statistics for the scene that just finished
+    _loop.print_stats(previous->name());
+    _power.report(previous->name());
+#if MBED_CONF_APP_PIPELINE
+    if (_pipeline) {
+        _pipeline->print_stats();
+        _pipeline->reset_stats();
+    }
+#endif
+    if (arena_high) {
+        printf("%s arena high water %u of %u bytes\n", previous->name(),
+               (unsigned)arena_high, (unsigned)_arena.capacity());
+    }
+    printf("%s -> %s in %u us\n", previous->name(), next->name(), (unsigned)took);
+
+    _governor.reset();  // each scene starts at full quality
+    set_tick(next->tick());
+    _loop.reset_stats();
+    _loop.resync();  // printing the statistics isn't the new scene's lag
+    _power.begin();
+}
@@ -0,0 +1,85 @@
+#ifndef SCENEMANAGER_H
+#define SCENEMANAGER_H
+
+#include "mbed.h"
+#include "N5110.h"
+#include "Scene.h"
+#include "InputSource.h"
+#include "FramePipeline.h"
+#include "GameLoop.h"
+#include "PowerMonitor.h"
+#include "FrameGovernor.h"
+#include "Arena.h"
+
+#ifndef MBED_CONF_APP_SCENE_ARENA_BYTES
+#define MBED_CONF_APP_SCENE_ARENA_BYTES 4096
+#endif
+
+/** SceneManager Class
+@brief Runs every scene on one fixed-timestep loop and switches between them
+
+Each tick the manager samples input once, hands it to the current scene and
+draws it. A scene change requested during a tick happens before that frame is
+drawn, so the frame that follows the request is already the new scene's.
+All scenes are constructed up front and preloaded ahead of time, so a switch is
+only the old scene's exit() and the new scene's enter(); the time it took is
+printed with the old scene's loop, power and pipeline statistics.
+
+The current scene allocates from one arena of app.scene-arena-bytes. It is
+reset on every switch, so memory use is the same however many times the games
+are played, and its high-water mark is printed for each scene that used it.
+
+With app.render-on-change, frames are only drawn when the scene is dirty, and
+the backlight and input rate drop after the idle timeout.
+
+The time each drawn frame takes is fed to a FrameGovernor with a budget of
+app.frame-budget-pct of the scene's tick. Scenes ask it, through
+Scene::quality(), which optional work to do; the manager switches the display
+to partial flushes itself once the governor drops QUALITY_FULL_FLUSH.
+
+Example:
+
+@code
+
+SceneManager scenes(lcd, input, &pipeline);
+scenes.add(SCENE_MENU, menu);
+scenes.add(SCENE_EXPLORE, explore);
+scenes.run(SCENE_MENU);
+
+@endcode
+*/
+class SceneManager
+{
+public:
+    SceneManager(N5110 &lcd, InputSource &input, FramePipeline *pipeline = nullptr);
+
+    void add(SceneId id, Scene &scene);
+    void change(SceneId next);   // switch at the end of the current tick
+    void preload(SceneId id);
+    void run(SceneId first);     // never returns
+    FrameGovernor const &governor() const;
+    Arena &arena();
+
+private:
+    void switch_scene();
+    void read_console();
+    void set_tick(Kernel::Clock::duration tick);
+
+    N5110 &_lcd;
+    InputSource &_input;
+    FramePipeline *_pipeline;
+    Scene *_scenes[SCENE_COUNT];
+    Scene *_current;
+    SceneId _next;
+    uint8_t _buttons;   // held last tick, for press edges
+
+    GameLoop _loop;
+    IdleTimer _idle;
+    PowerMonitor _power;
+    FrameGovernor _governor;
+
+    MBED_ALIGN(8) uint8_t _memory[MBED_CONF_APP_SCENE_ARENA_BYTES];
+    Arena _arena;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#include "Script.h"
+
+// Letters of a text box typed out per tick
+#define SCRIPT_TYPE_RATE 3
+// Letters across the screen
+#define SCRIPT_LINE_CHARS (WIDTH / 6)
+
+ScriptContext::ScriptContext() : _pressed(0), _text(nullptr), _shown(0), _length(0) {
+    _in.d = CENTRE;
+    _in.mag = 0;
+    _in.buttons = 0;
+}
+
+void ScriptContext::set_input(InputFrame const &in, uint8_t pressed) {
+    _in = in;
+    _pressed = pressed;
+}
+
+InputFrame const &ScriptContext::input() const { return _in; }
+
+bool ScriptContext::pressed(uint8_t buttons) const { return _pressed & buttons; }
+
+void ScriptContext::say(char const *text) {
+    _text = text;
+    _shown = 0;
+    _length = strlen(text);
+}
+
+void ScriptContext::close() { _text = nullptr; }
+
+bool ScriptContext::showing() const { return _text != nullptr; }
+
+bool ScriptContext::typed() const { return _shown >= _length; }
+
+void ScriptContext::tick() {
+    if (_text && _shown < _length) {
+        _shown += SCRIPT_TYPE_RATE;
+        if (_shown > _length) _shown = _length;
+    }
+}
+
+void ScriptContext::draw(N5110 &lcd, int row) const {
+    if (!_text) return;
+
+    int lines = 1;
+    for (int i = 0; i < _length; i++) {
+        if (_text[i] == '\n') lines++;
+    }
+    if (row + lines > BANKS) row = BANKS - lines;
+    if (row < 0) row = 0;
+
+    // blank the box, then type out the letters shown so far
+    lcd.drawRect(0, row * 8, WIDTH, lines * 8, FILL_WHITE);
+    int line = row;
+    int column = 0;
+    for (int i = 0; i < _shown; i++) {
+        char c = _text[i];
+        if (c == '\n') {
+            line++;
+            column = 0;
+        } else if (column < SCRIPT_LINE_CHARS) {
+            lcd.printChar(c, column * 6, line);
+            column++;
+        }
+    }
+}
+
+ScriptRunner::ScriptRunner() { }
+
+void ScriptRunner::init(Arena &arena, int capacity) {
+    _scripts.init(arena, capacity);
+}
+
+bool ScriptRunner::start(ScriptFn fn, int32_t arg) {
+    Script s;
+    s.fn = fn;
+    s.line = 0;
+    s.wait = 0;
+    s.arg = arg;
+    s.counter = 0;
+    return _scripts.push_back(s);
+}
+
+bool ScriptRunner::running(ScriptFn fn) const {
+    for (size_t i = 0; i < _scripts.size(); i++) {
+        if (_scripts[i].fn == fn) return true;
+    }
+    return false;
+}
+
+void ScriptRunner::stop_all() { _scripts.clear(); }
+
+void ScriptRunner::run(ScriptContext &ctx) {
+    ctx.tick();
+    size_t i = 0;
+    while (i < _scripts.size()) {
+        if (_scripts[i].fn(_scripts[i], ctx)) {
+            i++;
+        } else {
+            _scripts.remove(i);  // the last script moves here and runs next
+        }
+    }
+}
+
+int ScriptRunner::live() const { return _scripts.size(); }
@@ -0,0 +1,117 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include "mbed.h"
+#include "N5110.h"
+#include "Utils.h"
+#include "Arena.h"
+
+struct Script;
+class ScriptContext;
+
+/// A script body: runs until its next wait, returns false once finished
+typedef bool (*ScriptFn)(Script &s, ScriptContext &ctx);
+
+/** Script
+@brief State of one running script - 12 bytes, so hundreds can be live at once
+
+Scripts are protothread-style state machines: the body is an ordinary
+function whose SCRIPT_ macros record the line they stopped at and return, and
+the next call jumps straight back to that line through the switch opened by
+SCRIPT_BEGIN. Nothing is kept on the stack between ticks, so locals don't
+survive a wait - keep loop counters in counter and parameters in arg.
+
+As with any switch, a script can't wait inside a switch statement of its own.
+
+@code
+
+static bool blink(Script &s, ScriptContext &ctx) {
+    SCRIPT_BEGIN(s);
+    for (s.counter = 0; s.counter < 6; s.counter++) {
+        flash = !flash;
+        SCRIPT_WAIT_FRAMES(s, 1);
+    }
+    SCRIPT_SAY(s, ctx, "LEVEL UP\nPress select");
+    SCRIPT_WAIT_PRESS(s, ctx, BUTTON_SELECT);
+    ctx.close();
+    SCRIPT_END(s);
+}
+
+@endcode
+*/
+struct Script {
+    ScriptFn fn;
+    uint16_t line;     // where to resume, 0 = from the top
+    uint16_t wait;     // frames left in SCRIPT_WAIT_FRAMES
+    int32_t arg;       // set by ScriptRunner::start, e.g. a tile column
+    int16_t counter;   // free for the script's own loops
+};
+
+/// What scripts see each tick: the input, and a text box they can fill
+class ScriptContext
+{
+public:
+    ScriptContext();
+
+    void set_input(InputFrame const &in, uint8_t pressed);
+    InputFrame const &input() const;
+    bool pressed(uint8_t buttons) const;
+
+    void say(char const *text);   // '\n' separated lines, typed out a few letters a tick
+    void close();                 // clear the text box
+    bool showing() const;         // a text box is up - scenes pause their game while it is
+    bool typed() const;           // the whole text is on screen
+    void tick();
+    void draw(N5110 &lcd, int row) const;  // text box from bank row down
+
+private:
+    InputFrame _in;
+    uint8_t _pressed;
+    char const *_text;
+    uint16_t _shown;   // letters typed out so far
+    uint16_t _length;
+};
+
+/// Fixed pool of running scripts, stepped once a tick
+class ScriptRunner
+{
+public:
+    ScriptRunner();
+
+    void init(Arena &arena, int capacity);        // pool in the scene arena
+    bool start(ScriptFn fn, int32_t arg = 0);     // false when the pool is full
+    bool running(ScriptFn fn) const;
+    void stop_all();
+    void run(ScriptContext &ctx);                 // step every script once, drop the finished
+    int live() const;
+
+private:
+    FixedArray<Script> _scripts;
+};
+
+// --- Script body macros ---
+#define SCRIPT_BEGIN(s) switch ((s).line) { case 0:
+
+// Give up the rest of this tick
+#define SCRIPT_YIELD(s) \
+    do { (s).line = __LINE__; return true; case __LINE__:; } while (0)
+
+// Resume after n ticks
+#define SCRIPT_WAIT_FRAMES(s, n) \
+    do { (s).wait = (n); (s).line = __LINE__; case __LINE__: \
+         if ((s).wait > 0) { (s).wait--; return true; } } while (0)
+
+// Resume on the first tick that cond holds, which may be this one
+#define SCRIPT_WAIT_UNTIL(s, cond) \
+    do { (s).line = __LINE__; case __LINE__: if (!(cond)) return true; } while (0)
+
+// Resume when one of the buttons is pressed
+#define SCRIPT_WAIT_PRESS(s, ctx, buttons) SCRIPT_WAIT_UNTIL(s, (ctx).pressed(buttons))
+
+// Show text and resume once it has all been typed out
+#define SCRIPT_SAY(s, ctx, text) \
+    do { (ctx).say(text); SCRIPT_WAIT_UNTIL(s, (ctx).typed()); } while (0)
+
+#define SCRIPT_END(s) } (s).line = 0; return false
+
+#endif
@@ -1,34 +1,31 @@
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
 #include "SelectTool.h"
 
+static const AnimFrame HOVER_FRAMES[] = {
+    { SELECT_HOVER_CENTRE,     3 }, { SELECT_HOVER_CENTRE + 1, 2 },
+    { SELECT_HOVER_CENTRE + 2, 4 }, { SELECT_HOVER_CENTRE + 1, 2 },
+    { SELECT_HOVER_CENTRE,     3 }, { SELECT_HOVER_CENTRE - 1, 2 },
+    { SELECT_HOVER_CENTRE - 2, 4 }, { SELECT_HOVER_CENTRE - 1, 2 },
+};
+const AnimClip SELECT_HOVER = ANIM_CLIP(HOVER_FRAMES);
+
 SelectTool::SelectTool() : _base_x(0), _base_y(0), _x(0), _y(0),
-                           _width(0), _height(0),
-                           _amplitude(0), _phase(0), _phaseDelta(0) { }
+                           _width(0), _height(0) { }
 
-void SelectTool::init(int baseX, int baseY, int width, int height, float amplitude, float phaseDelta) {
+void SelectTool::init(int baseX, int baseY, int width, int height, AnimClip const &hover) {
     _base_x = baseX;
     _base_y = baseY;
     _width = width;
     _height = height;
-    _amplitude = amplitude;
-    _phaseDelta = phaseDelta;
-    _phase = 0;
-    _x = _base_x;
+    _hover.play(hover);
+    _x = _base_x + _hover.image() - SELECT_HOVER_CENTRE;
     _y = _base_y;
 }
 
-void SelectTool::update() {
-    // Increase phase for oscillation
-    _phase += _phaseDelta;
-    if (_phase > 2 * M_PI) {
-        _phase -= 2 * M_PI;
-    }
-    // Calculate horizontal offset using sine function
-    int offset = (int)(_amplitude * sin(_phase));
-    _x = _base_x + offset;
+bool SelectTool::update() {
+    if (!_hover.tick()) return false;
+    _x = _base_x + _hover.image() - SELECT_HOVER_CENTRE;
     // _y remains as the base y
+    return true;
 }
 
 void SelectTool::draw(N5110 &lcd) {
@@ -4,19 +4,21 @@
 #include "mbed.h"
 #include "N5110.h"
 #include "Utils.h"    // for Position2D
-#include <math.h>
+#include "Animation.h"
 
-// If M_PI is not defined, define it.
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+// Hover frames are x offsets from the anchor, stored plus this so they fit an image
+#define SELECT_HOVER_CENTRE 2
+
+/// The default hover: out and back either side, lingering at each end
+extern const AnimClip SELECT_HOVER;
 
 /**
  * @brief A hovering select tool to indicate the current menu item.
  *
  * This class represents an indicator that “hovers” (oscillates horizontally)
  * next to a menu option. Its base (anchor) position is set by the menu code,
- * and update() applies a sine‑based horizontal offset.
+ * and update() steps a hover clip whose frames are horizontal offsets, so the
+ * easing is data in flash rather than a sin() every frame.
  */
 class SelectTool {
 public:
@@ -28,13 +30,12 @@ public:
      * @param baseY The base (anchor) Y coordinate.
      * @param width The width of the tool.
      * @param height The height of the tool.
-     * @param amplitude The maximum horizontal offset (hover amplitude).
-     * @param phaseDelta The amount to change the phase on each update.
+     * @param hover Offsets to cycle through, plus SELECT_HOVER_CENTRE.
      */
-    void init(int baseX, int baseY, int width, int height, float amplitude, float phaseDelta);
+    void init(int baseX, int baseY, int width, int height, AnimClip const &hover = SELECT_HOVER);
 
-    /// Update the tool (applies the hover effect).
-    void update();
+    /// Update the tool (applies the hover effect); true if it moved.
+    bool update();
 
     /// Draw the tool on the LCD.
     void draw(N5110 &lcd);
@@ -52,9 +53,7 @@ private:
     int _y;         // Current y-position (same as _base_y)
     int _width;     
     int _height;
-    float _amplitude;   // Maximum horizontal displacement for hover effect
-    float _phase;       // Current phase for sine oscillation
-    float _phaseDelta;  // How much the phase changes per update
+    Animation _hover;   // Current hover offset
 };
 
 #endif
\ No newline at end of file
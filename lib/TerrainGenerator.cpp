@@ -0,0 +1,93 @@
+#include "TerrainGenerator.h"
+#include "Random.h"
+
+// Where the first chunk puts the habitat, next to the start position
+static const int LANDING_HAB_X = 7;
+
+// Keep the landing site quiet: no terminals in the first few segments
+static const int FIRST_TERMINAL_SEGMENT = 6;
+
+TerrainGenerator::TerrainGenerator(uint32_t seed) : _seed(seed) { }
+
+int TerrainGenerator::chunk_count() const { return INT16_MAX; }
+
+// Integer mix of the seed and a position, so any segment can be made on its own
+uint32_t TerrainGenerator::hash(int segment, uint32_t salt) const {
+    uint32_t x = _seed ^ (uint32_t)segment * 0x9E3779B9u ^ salt;
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+int TerrainGenerator::ground(int segment) const {
+    if (segment < 2) return MAP_HEIGHT - 1;
+    return MAP_HEIGHT - 1 - hash(segment, 0x67726E64u) % 3;  // 0 to 2 tiles of hill
+}
+
+void TerrainGenerator::build_segment(Chunk &chunk, int x0, int segment) {
+    int g = ground(segment);
+    for (int x = x0; x < x0 + TERRAIN_SEGMENT; x++) {
+        for (int y = g; y < MAP_HEIGHT; y++) chunk.set(x, y, TILE_WALL);
+    }
+
+    if (segment == 0) {
+        for (int y = 0; y < MAP_HEIGHT; y++) chunk.set(0, y, TILE_WALL);
+        for (int x = LANDING_HAB_X; x < LANDING_HAB_X + 3; x++) {
+            chunk.set(x, g - 1, TILE_HAB);
+            chunk.set(x, g - 2, TILE_HAB);
+        }
+        return;
+    }
+    if (segment == 1) return;
+
+    // one feature, clear of the segment edges so features never touch
+    Random rng(hash(segment, 0x66656174u));
+    int x = x0 + 1 + rng.range(2);
+    switch (rng.range(10)) {
+        case 0:
+        case 1: {                                   // crater: a two-high rim
+            for (int i = 0; i < 5; i++) chunk.set(x + i, g - 1, TILE_CRATER);
+            for (int i = 1; i < 4; i++) chunk.set(x + i, g - 2, TILE_CRATER);
+            break;
+        }
+        case 2:
+        case 3: {                                   // parked rovers
+            int n = 2 + rng.range(3);
+            for (int i = 0; i < n; i++) chunk.set(x + i, g - 1, TILE_ROVER);
+            break;
+        }
+        case 4: {                                   // terminals
+            if (segment < FIRST_TERMINAL_SEGMENT) break;
+            for (int i = 0; i < 3; i++) chunk.set(x + i, g - 1, TILE_TERMINAL);
+            break;
+        }
+        case 5: {                                   // habitat, only now and then
+            if (rng.range(3) != 0) break;
+            for (int i = 0; i < 3; i++) {
+                chunk.set(x + i, g - 1, TILE_HAB);
+                chunk.set(x + i, g - 2, TILE_HAB);
+            }
+            break;
+        }
+        case 6:
+        case 7: {                                   // ledge to jump onto
+            int y = g - 3 - rng.range(2);
+            int n = 3 + rng.range(3);
+            for (int i = 0; i < n; i++) chunk.set(x + i, y, TILE_WALL);
+            break;
+        }
+        default:                                    // open ground
+            break;
+    }
+}
+
+bool TerrainGenerator::load(int index, Chunk &chunk) {
+    if (index < 0 || index >= chunk_count()) return false;
+    for (int i = 0; i < CHUNK_WIDTH / TERRAIN_SEGMENT; i++) {
+        build_segment(chunk, i * TERRAIN_SEGMENT, index * (CHUNK_WIDTH / TERRAIN_SEGMENT) + i);
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef TERRAINGENERATOR_H
+#define TERRAINGENERATOR_H
+
+#include "mbed.h"
+#include "ChunkSource.h"
+
+// Terrain is laid out in flat segments this many columns wide, two per chunk
+#define TERRAIN_SEGMENT 8
+
+/** TerrainGenerator Class
+@brief Endless Mars terrain, generated a chunk at a time from a seed
+
+Every segment of the ground gets its height and at most one feature - a
+crater, parked rovers, a row of terminals, a habitat or a floating ledge -
+from a hash of the seed and the segment's position. A chunk is therefore
+generated on its own in any order and always comes out the same, so a
+ChunkCache can drop it and make it again later, and recorded sessions replay
+identically. Nothing is built up front and no RAM is used beyond the cache.
+
+The first chunk is the classic landing site: flat ground, a wall on the left
+and the habitat by the start position.
+
+Example:
+
+@code
+
+TerrainGenerator terrain(1234);
+ChunkCache world;
+world.init(arena, 4, terrain, 32);
+
+@endcode
+*/
+class TerrainGenerator : public ChunkSource
+{
+public:
+    TerrainGenerator(uint32_t seed);
+
+    int chunk_count() const override;  // as many as a ChunkCache can index
+    bool load(int index, Chunk &chunk) override;
+
+private:
+    uint32_t hash(int segment, uint32_t salt) const;
+    int ground(int segment) const;     // top solid row
+    void build_segment(Chunk &chunk, int x0, int segment);
+
+    uint32_t _seed;
+};
+
+#endif
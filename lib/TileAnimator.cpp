@@ -0,0 +1,65 @@
+#include "TileAnimator.h"
+
+TileAnimator::TileAnimator() : _tile(nullptr), _frame(nullptr), _changed(0) {
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) _first[t] = -1;
+}
+
+void TileAnimator::init(Arena &arena) {
+    int groups = 0;
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        _first[t] = TILE_CLIPS[t].count ? groups : -1;
+        if (TILE_CLIPS[t].count) groups += TILE_PHASES;
+    }
+    if (groups > 32) error("TileAnimator: %d groups, the changed mask holds 32\n", groups);
+
+    _tile = arena.array<uint8_t>(groups);
+    _frame = arena.array<uint8_t>(groups);
+    _wheel.init(arena, groups);
+    _changed = 0;
+
+    // group p starts p quarters of the way through its clip
+    for (int t = 0; t < TILE_TYPE_COUNT; t++) {
+        AnimClip const &clip = TILE_CLIPS[t];
+        if (!clip.count) continue;
+        int length = 0;
+        for (int f = 0; f < clip.count; f++) length += clip.frames[f].ticks;
+
+        for (int p = 0; p < TILE_PHASES; p++) {
+            int g = _first[t] + p;
+            int into = p * length / TILE_PHASES;
+            int f = 0;
+            while (into >= clip.frames[f].ticks) into -= clip.frames[f++].ticks;
+            _tile[g] = t;
+            _frame[g] = f;
+            _wheel.schedule(g, clip.frames[f].ticks - into);
+        }
+    }
+}
+
+bool TileAnimator::tick() {
+    _changed = 0;
+    _wheel.advance();
+    for (int g = _wheel.pop(); g >= 0; g = _wheel.pop()) {
+        AnimClip const &clip = TILE_CLIPS[_tile[g]];
+        uint8_t before = clip.frames[_frame[g]].image;
+        _frame[g] = (_frame[g] + 1) % clip.count;
+        if (clip.frames[_frame[g]].image != before) _changed |= 1u << g;
+        _wheel.schedule(g, clip.frames[_frame[g]].ticks);
+    }
+    return _changed != 0;
+}
+
+int TileAnimator::group(uint8_t tile, int x, int y) const {
+    if (tile >= TILE_TYPE_COUNT || _first[tile] < 0 || !_frame) return -1;
+    return _first[tile] + ((x * 3 + y) & (TILE_PHASES - 1));
+}
+
+uint8_t TileAnimator::image(uint8_t tile, int x, int y) const {
+    int g = group(tile, x, y);
+    return g < 0 ? tile : TILE_CLIPS[tile].frames[_frame[g]].image;
+}
+
+bool TileAnimator::changed(uint8_t tile, int x, int y) const {
+    int g = group(tile, x, y);
+    return g >= 0 && ((_changed >> g) & 1);
+}
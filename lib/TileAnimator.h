@@ -0,0 +1,49 @@
+#ifndef TILEANIMATOR_H
+#define TILEANIMATOR_H
+
+#include "mbed.h"
+#include "Arena.h"
+#include "TileAtlas.h"
+#include "TimingWheel.h"
+
+// Animated tiles of a type are split by position into this many groups, each
+// running its clip from a different point so they don't all change together
+#define TILE_PHASES 4
+
+static_assert((TILE_PHASES & (TILE_PHASES - 1)) == 0, "the group is the position masked");
+
+/** TileAnimator Class
+@brief Plays TILE_CLIPS on every animated tile in a world at once
+
+A tile keeps no animation state of its own. Which frame a tile shows
+depends only on its type and the group its position falls in, so a map
+full of terminals costs no more than one terminal. Each group is a timer
+on a TimingWheel that fires when its next frame is due, so a tick only
+touches the groups whose frame changes.
+
+tick() is called once per scene update and says whether any group
+changed. changed() then tells whether a tile on screen is among them, so a
+scene that draws only on change knows when a redraw is needed.
+*/
+class TileAnimator
+{
+public:
+    TileAnimator();
+
+    void init(Arena &arena);
+    bool tick();                                       // true if any tile changed frame
+
+    uint8_t image(uint8_t tile, int x, int y) const;   // TILE_ATLAS image of the tile at (x, y)
+    bool changed(uint8_t tile, int x, int y) const;    // its frame moved on at the last tick
+
+private:
+    int group(uint8_t tile, int x, int y) const;       // -1 for still tiles
+
+    TimingWheel _wheel;
+    int8_t _first[TILE_TYPE_COUNT];  // first group of each type, -1 if still
+    uint8_t *_tile;                  // per group: its tile type
+    uint8_t *_frame;                 // per group: the frame it is on
+    uint32_t _changed;               // bit per group
+};
+
+#endif
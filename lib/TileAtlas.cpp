@@ -0,0 +1,55 @@
+#include "TileAtlas.h"
+
+const unsigned char TILE_ATLAS[TILE_IMAGE_COUNT][TILE_SIZE] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },  // TILE_EMPTY
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF },  // TILE_WALL
+    { 0x00, 0xE0, 0xF0, 0xF8, 0xF8, 0xF0, 0xE0, 0x00 },  // TILE_HAB - small dome
+    { 0x38, 0xF8, 0xF8, 0x38, 0x38, 0xF8, 0xFE, 0x38 },  // TILE_ROVER - body, wheels and mast
+    { 0x00, 0x04, 0x0A, 0x09, 0x09, 0x0A, 0x04, 0x00 },  // TILE_CRATER
+    { 0x00, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x00 },  // TILE_TERMINAL
+    { 0x7E, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x7E },  // TILE_IMAGE_TERMINAL_LIT - screen lit
+    { 0x00, 0x04, 0x0A, 0x09, 0x09, 0x0A, 0x05, 0x02 },  // TILE_IMAGE_CRATER_DUST - dust lifting
+    { 0x01, 0x04, 0x0A, 0x09, 0x09, 0x0A, 0x04, 0x00 },  // TILE_IMAGE_CRATER_DRIFT - and blowing off
+};
+
+// Terminals flash now and then; craters sometimes give off a puff of dust
+static const AnimFrame TERMINAL_FRAMES[] = {
+    { TILE_TERMINAL, 40 }, { TILE_IMAGE_TERMINAL_LIT, 4 }, { TILE_TERMINAL, 4 }, { TILE_IMAGE_TERMINAL_LIT, 4 },
+};
+static const AnimFrame CRATER_FRAMES[] = {
+    { TILE_CRATER, 90 }, { TILE_IMAGE_CRATER_DUST, 6 }, { TILE_IMAGE_CRATER_DRIFT, 6 },
+};
+
+const AnimClip TILE_CLIPS[TILE_TYPE_COUNT] = {
+    { nullptr, 0 },                 // TILE_EMPTY
+    { nullptr, 0 },                 // TILE_WALL
+    { nullptr, 0 },                 // TILE_HAB - drawn as the habitat picture
+    { nullptr, 0 },                 // TILE_ROVER
+    ANIM_CLIP(CRATER_FRAMES),       // TILE_CRATER
+    ANIM_CLIP(TERMINAL_FRAMES),     // TILE_TERMINAL
+};
+
+// The habitat picture as two banks of 24 columns: dome, then wall with window and door
+static const unsigned char HAB_BANKS[HAB_ROWS][HAB_COLUMNS * TILE_SIZE] = {
+    { 0xDF, 0xCF, 0x17, 0xD7, 0xDB, 0xDB, 0xDD, 0xDD, 0xDE, 0xDE, 0xDE, 0xDE,
+      0x5E, 0x5E, 0x5E, 0x5D, 0x5D, 0x5B, 0x5B, 0xD7, 0xD7, 0xCF, 0xDF, 0xFF },
+    { 0xFF, 0xFF, 0x00, 0x7F, 0x70, 0x76, 0x76, 0x70, 0x76, 0x70, 0x7F, 0x7F,
+      0x00, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x00, 0x7F, 0x7F, 0xFF, 0xFF, 0xFF },
+};
+
+void drawTile(N5110 &lcd, int image, int col, int row) {
+    lcd.blitBank(col * TILE_SIZE, TILE_FIRST_BANK + row, TILE_ATLAS[image], TILE_SIZE);
+}
+
+void drawTileDimmed(N5110 &lcd, int image, int col, int row) {
+    unsigned char dimmed[TILE_SIZE];
+    for (int i = 0; i < TILE_SIZE; i++) dimmed[i] = TILE_ATLAS[image][i] & (i & 1 ? 0xAA : 0x55);
+    lcd.blitBank(col * TILE_SIZE, TILE_FIRST_BANK + row, dimmed, TILE_SIZE);
+}
+
+void drawHabitat(N5110 &lcd, int col, int row, int rows) {
+    for (int i = 0; i < HAB_ROWS; i++) {
+        if (row + i < 0 || row + i >= rows) continue;
+        lcd.blitBank(col * TILE_SIZE, TILE_FIRST_BANK + row + i, HAB_BANKS[i], HAB_COLUMNS * TILE_SIZE);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef TILEATLAS_H
+#define TILEATLAS_H
+
+#include "mbed.h"
+#include "N5110.h"
+#include "Animation.h"
+
+// Tile types, shared by the explorer and the map editor
+#define TILE_EMPTY    0  // No tile
+#define TILE_WALL     1  // Solid block
+#define TILE_HAB      2  // Habitat module
+#define TILE_ROVER    3  // Parked rover
+#define TILE_CRATER   4  // Crater rim
+#define TILE_TERMINAL 5  // Terminal
+#define TILE_TYPE_COUNT 6  // Update if you add more tiles
+
+// Animation frames are kept in the atlas after the tiles
+#define TILE_IMAGE_TERMINAL_LIT  (TILE_TYPE_COUNT + 0)
+#define TILE_IMAGE_CRATER_DUST   (TILE_TYPE_COUNT + 1)
+#define TILE_IMAGE_CRATER_DRIFT  (TILE_TYPE_COUNT + 2)
+#define TILE_IMAGE_COUNT         (TILE_TYPE_COUNT + 3)
+
+// Tiles are one display bank tall, so a tile row is one bank
+#define TILE_SIZE 8
+
+// Tile rows on screen start below the status line in bank 0
+#define TILE_FIRST_BANK 1
+
+// The habitat landmark is a picture 3 tiles wide and 2 high, the size every
+// world stamps habitats at
+#define HAB_COLUMNS 3
+#define HAB_ROWS 2
+
+/*
+ * The atlas holds every tile as 8 column bytes in display order - bit 0 is
+ * the top pixel - so drawing a bank-aligned tile is an 8-byte copy into the
+ * screen buffer. Image n is tile ID n, then come the animation frames. It
+ * lives in flash.
+ */
+extern const unsigned char TILE_ATLAS[TILE_IMAGE_COUNT][TILE_SIZE];
+
+/// How each tile type animates, as atlas images; still tiles have no frames
+extern const AnimClip TILE_CLIPS[TILE_TYPE_COUNT];
+
+/// Draw atlas image at screen tile column col, tile row row (0 = first bank under the status line)
+void drawTile(N5110 &lcd, int image, int col, int row);
+
+/// Draw an image at half density, for places remembered but not in sight
+void drawTileDimmed(N5110 &lcd, int image, int col, int row);
+
+/// Draw the 24x16 habitat picture with its top-left tile at screen tile col, row,
+/// clipped to the tile rows 0 to rows - 1
+void drawHabitat(N5110 &lcd, int col, int row, int rows);
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include "mbed.h"
+#include "TileAtlas.h"
+
+// World size in tiles - the explorer and the editor share it
+#define MAP_WIDTH 60
+#define MAP_HEIGHT 8
+
+// Tile the explorer starts in, so the editor can tell what is reachable
+#define MAP_START_X 2
+#define MAP_START_Y 6
+
+// Tile property flags
+#define TILE_SOLID 0x01  // blocks movement
+
+/// What the game needs to know about a tile type
+struct TileProps {
+    uint8_t flags;
+    char const *name;
+};
+
+// constexpr so levels can be packed at compile time (see FlashLevel.h)
+constexpr TileProps TILE_PROPS[TILE_TYPE_COUNT] = {
+    { 0,          "Empty" },
+    { TILE_SOLID, "Wall" },
+    { TILE_SOLID, "Habitat" },
+    { TILE_SOLID, "Rover" },
+    { TILE_SOLID, "Crater" },
+    { TILE_SOLID, "Terminal" },
+};
+
+// Level art: one character per tile ID, as in tools/worldpack.py
+#define TILE_CHARS ".#HROT"
+
+/// Tile ID drawn by a level art character, TILE_TYPE_COUNT if none
+constexpr uint8_t tile_from_char(char c) {
+    for (uint8_t tile = 0; tile < TILE_TYPE_COUNT; tile++) {
+        if (TILE_CHARS[tile] == c) return tile;
+    }
+    return TILE_TYPE_COUNT;
+}
+
+/** TileGrid Class
+@brief COLUMNS x MAP_HEIGHT tiles packed two to a byte, with a solidity bitset
+
+Each tile ID (0-15) takes 4 bits, so a 60-column map is 240 bytes instead of
+the 1,920 an int per tile needed. Alongside the tiles, every row keeps one bit
+per column that is set when the tile there has TILE_SOLID, kept up to date by
+set(), so collision and ground checks are a single bit test.
+
+Accessors are bounds-checked: outside the grid get() reads TILE_WALL and
+solid() is true, so the edge of the world always blocks, and set() does
+nothing.
+
+There is no constructor: zero-filled memory is an empty grid, so a grid can
+be a static or live in an Arena.
+*/
+template <int COLUMNS>
+class TileGrid
+{
+    static_assert(COLUMNS % 2 == 0 && COLUMNS <= 64, "two tiles per byte, one bitset word per row");
+
+public:
+    void clear() {                             // all TILE_EMPTY
+        memset(_cells, 0, sizeof(_cells));
+        memset(_solid, 0, sizeof(_solid));
+    }
+
+    uint8_t get(int x, int y) const {
+        if (!in_bounds(x, y)) return TILE_WALL;
+        uint8_t pair = _cells[y][x >> 1];
+        return (x & 1) ? pair >> 4 : pair & 0x0F;
+    }
+
+    bool set(int x, int y, uint8_t tile) {     // false if out of bounds or not a tile type
+        if (!in_bounds(x, y) || tile >= TILE_TYPE_COUNT) return false;
+
+        uint8_t &pair = _cells[y][x >> 1];
+        pair = (x & 1) ? (pair & 0x0F) | (tile << 4) : (pair & 0xF0) | tile;
+
+        uint64_t bit = (uint64_t)1 << x;
+        if (TILE_PROPS[tile].flags & TILE_SOLID) {
+            _solid[y] |= bit;
+        } else {
+            _solid[y] &= ~bit;
+        }
+        return true;
+    }
+
+    bool solid(int x, int y) const {
+        if (!in_bounds(x, y)) return true;
+        return (_solid[y] >> x) & 1;
+    }
+
+    uint64_t solid_row(int y) const {          // bit x set when column x is solid
+        if (y < 0 || y >= MAP_HEIGHT) return ~(uint64_t)0;
+        return _solid[y];
+    }
+
+    static bool in_bounds(int x, int y) {
+        return x >= 0 && x < COLUMNS && y >= 0 && y < MAP_HEIGHT;
+    }
+
+private:
+    uint8_t _cells[MAP_HEIGHT][COLUMNS / 2];     // even columns in the low nibble
+    uint64_t _solid[MAP_HEIGHT];
+};
+
+/// The editor's whole map
+typedef TileGrid<MAP_WIDTH> TileMap;
+
+#endif
@@ -0,0 +1,24 @@
+#include "TileOverlay.h"
+
+void TileOverlay::init(Arena &arena, int capacity) {
+    _edits.init(arena, capacity);
+}
+
+int TileOverlay::find(int x, int y) const {
+    for (size_t i = 0; i < _edits.size(); i++) {
+        if (_edits[i].x == x && _edits[i].y == y) return i;
+    }
+    return -1;
+}
+
+bool TileOverlay::set(int x, int y, uint8_t tile, uint8_t was) {
+    int i = find(x, y);
+    if (i >= 0) {
+        if (tile == _edits[i].source) _edits.remove(i);
+        else _edits[i].tile = tile;
+        return true;
+    }
+    if (tile == was) return true;   // no entry, so was is the source
+    TileEdit edit = { x, (uint8_t)y, tile, was };
+    return _edits.push_back(edit);
+}
@@ -0,0 +1,40 @@
+#ifndef TILEOVERLAY_H
+#define TILEOVERLAY_H
+
+#include "mbed.h"
+#include "Arena.h"
+
+/// A tile changed from what a world's source says is there
+struct TileEdit {
+    int32_t x;
+    uint8_t y;
+    uint8_t tile;
+    uint8_t source;  // what was there before the first change
+};
+
+/** TileOverlay Class
+@brief Short list of tile changes laid over read-only world data
+
+Changes to flash levels and streamed chunks are kept here rather than in
+the data itself, so a world only costs RAM for what has changed. Setting a
+tile that was already changed updates its entry, and setting it back to
+what the source says drops the entry, so a tile changed to and fro (a
+rover waking and parking) doesn't keep one.
+*/
+class TileOverlay
+{
+public:
+    void init(Arena &arena, int capacity);
+
+    bool set(int x, int y, uint8_t tile, uint8_t was);  // was: the tile there now; false when full
+    int find(int x, int y) const;          // index of the change, -1 if none
+
+    TileEdit const &operator[](size_t i) const { return _edits[i]; }
+    size_t size() const { return _edits.size(); }
+    size_t capacity() const { return _edits.capacity(); }
+
+private:
+    FixedArray<TileEdit> _edits;
+};
+
+#endif
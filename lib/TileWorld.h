@@ -0,0 +1,62 @@
+#ifndef TILEWORLD_H
+#define TILEWORLD_H
+
+#include "mbed.h"
+#include "TileMap.h"
+
+/** TileWorld Class
+@brief A MAP_HEIGHT-tall strip of tiles to explore, wherever the tiles come from
+
+The explorer only moves, collides and draws through this, so the same code
+walks a level read in place from flash (FlashLevel) or a world streamed in
+chunks (ChunkCache). Coordinates are in tiles from the top-left; outside the
+world get() reads TILE_WALL and solid() is true, so the edges always block.
+
+set() changes a tile for as long as the world is in use, without touching
+where it came from; it fails outside the world or when there is no room left
+to remember the change. revision() moves on with every change, so anything
+derived from the tiles (see FieldOfView) can tell when to work it out again.
+*/
+class TileWorld
+{
+public:
+    virtual ~TileWorld() { }
+
+    virtual int width() const = 0;
+    virtual uint8_t get(int x, int y) = 0;
+    virtual bool solid(int x, int y) = 0;
+    virtual bool set(int x, int y, uint8_t tile) = 0;
+
+    virtual void focus(int x, int width, int direction) { }  // the viewport, once a tick
+    virtual void report() const { }
+
+    uint32_t revision() const { return _revision; }
+
+protected:
+    TileWorld() : _revision(0) { }
+
+    uint32_t _revision;  // bumped by set()
+};
+
+/// A TileMap in RAM seen as a TileWorld, such as the map being edited
+class TileMapWorld : public TileWorld
+{
+public:
+    TileMapWorld() : _map(nullptr) { }
+
+    void attach(TileMap *map) { _map = map; _revision++; }
+
+    int width() const override { return MAP_WIDTH; }
+    uint8_t get(int x, int y) override { return _map->get(x, y); }
+    bool solid(int x, int y) override { return _map->solid(x, y); }
+    bool set(int x, int y, uint8_t tile) override {
+        if (!_map->set(x, y, tile)) return false;
+        _revision++;
+        return true;
+    }
+
+private:
+    TileMap *_map;
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "TimingWheel.h"
+
+TimingWheel::TimingWheel() : _next(nullptr), _rounds(nullptr), _due(WHEEL_NONE), _cursor(0) {
+    for (int i = 0; i < WHEEL_SLOTS; i++) _slots[i] = WHEEL_NONE;
+}
+
+void TimingWheel::init(Arena &arena, int timers) {
+    _next = arena.array<uint16_t>(timers);
+    _rounds = arena.array<uint16_t>(timers);
+    for (int i = 0; i < WHEEL_SLOTS; i++) _slots[i] = WHEEL_NONE;
+    _due = WHEEL_NONE;
+    _cursor = 0;
+}
+
+void TimingWheel::schedule(int id, uint32_t ticks) {
+    if (ticks == 0) ticks = 1;
+    int slot = (_cursor + ticks) & (WHEEL_SLOTS - 1);
+    _rounds[id] = (ticks - 1) / WHEEL_SLOTS;
+    _next[id] = _slots[slot];
+    _slots[slot] = id;
+}
+
+void TimingWheel::advance() {
+    _cursor = (_cursor + 1) & (WHEEL_SLOTS - 1);
+
+    // split the slot into the timers due now and those with rounds to go
+    uint16_t id = _slots[_cursor];
+    _slots[_cursor] = WHEEL_NONE;
+    while (id != WHEEL_NONE) {
+        uint16_t next = _next[id];
+        if (_rounds[id] == 0) {
+            _next[id] = _due;
+            _due = id;
+        } else {
+            _rounds[id]--;
+            _next[id] = _slots[_cursor];
+            _slots[_cursor] = id;
+        }
+        id = next;
+    }
+}
+
+int TimingWheel::pop() {
+    if (_due == WHEEL_NONE) return -1;
+    int id = _due;
+    _due = _next[id];
+    return id;
+}
@@ -0,0 +1,56 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include "mbed.h"
+#include "Arena.h"
+
+// Slots around the wheel; timers further off go round it more than once
+#define WHEEL_SLOTS 32
+#define WHEEL_NONE 0xFFFF
+
+static_assert((WHEEL_SLOTS & (WHEEL_SLOTS - 1)) == 0, "the slot is the tick masked");
+
+/** TimingWheel Class
+@brief Many timers counted in ticks, where a tick only touches the ones due
+
+Each slot holds a list of the timers that fall due on it, linked through
+one array so a timer is just its id. advance() moves on one slot and walks
+only that slot's list: timers with rounds still to go stay, the rest come
+out of pop(). Thousands of idle timers cost nothing per tick, and
+scheduling is O(1).
+
+A timer is in at most one slot: schedule it again only once it has fired.
+
+Example:
+
+@code
+
+wheel.init(arena, 64);
+wheel.schedule(id, 10);
+...
+wheel.advance();                 // once a tick
+for (int id = wheel.pop(); id >= 0; id = wheel.pop()) {
+    wheel.schedule(id, fire(id));
+}
+
+@endcode
+*/
+class TimingWheel
+{
+public:
+    TimingWheel();
+
+    void init(Arena &arena, int timers);     // ids 0 to timers - 1, none scheduled
+    void schedule(int id, uint32_t ticks);   // due that many ticks from now, at least 1
+    void advance();
+    int pop();                               // a timer due this tick, -1 when there are no more
+
+private:
+    uint16_t *_next;      // per timer, the next one in its list
+    uint16_t *_rounds;    // per timer, times round the wheel still to go
+    uint16_t _slots[WHEEL_SLOTS];
+    uint16_t _due;        // list of timers due this tick
+    int _cursor;
+};
+
+#endif
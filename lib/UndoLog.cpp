@@ -0,0 +1,87 @@
+#include "UndoLog.h"
+
+// Entries with this bit start an edit, with its tile in the low bits; the
+// rest are a tile's index (x * MAP_HEIGHT + y) with its old tile above
+#define UNDO_EDIT 0x8000
+#define UNDO_OLD_SHIFT 9
+#define UNDO_CELL_MASK 0x1FF
+
+UndoLog::UndoLog()
+    : _entries(nullptr), _capacity(0), _start(0), _end(0), _cursor(0), _edit(0), _overflow(false) { }
+
+void UndoLog::init(Arena &arena, int entries) {
+    _entries = arena.array<uint16_t>(entries);
+    _capacity = entries;
+    clear();
+}
+
+void UndoLog::clear() {
+    _start = _end = _cursor = _edit = 0;
+    _overflow = false;
+}
+
+uint16_t &UndoLog::at(uint32_t position) { return _entries[position % _capacity]; }
+
+void UndoLog::push(uint16_t entry) {
+    if (_overflow) return;
+    if (_end - _start == _capacity) {
+        if (_start == _edit) {
+            // this edit alone fills the ring: keep no history rather than half of it
+            clear();
+            _overflow = true;
+            return;
+        }
+        // forget the oldest edit, whole
+        do {
+            _start++;
+        } while (_start < _end && !(at(_start) & UNDO_EDIT));
+    }
+    at(_end++) = entry;
+}
+
+void UndoLog::begin(uint8_t tile) {
+    _end = _cursor;
+    _overflow = false;
+    _edit = _end;
+    push(UNDO_EDIT | tile);
+    _cursor = _end;
+}
+
+void UndoLog::record(int x, int y, uint8_t old) {
+    push((x * MAP_HEIGHT + y) | (old << UNDO_OLD_SHIFT));
+    _cursor = _end;
+}
+
+// An edit that changed nothing isn't worth an undo step
+void UndoLog::end() {
+    if (!_overflow && _end == _edit + 1 && _end > _start) {
+        _end = _cursor = _edit;
+    }
+    _overflow = false;
+}
+
+bool UndoLog::undo(Callback<void(int, int, uint8_t)> put) {
+    if (_cursor == _start) return false;
+    uint32_t position = _cursor;
+    while (position > _start) {
+        uint16_t entry = at(--position);
+        if (entry & UNDO_EDIT) break;
+        int cell = entry & UNDO_CELL_MASK;
+        put(cell / MAP_HEIGHT, cell % MAP_HEIGHT, entry >> UNDO_OLD_SHIFT);
+    }
+    _cursor = position;
+    return true;
+}
+
+bool UndoLog::redo(Callback<void(int, int, uint8_t)> put) {
+    if (_cursor == _end) return false;
+    uint8_t tile = at(_cursor) & ~UNDO_EDIT;
+    uint32_t position = _cursor + 1;
+    while (position < _end && !(at(position) & UNDO_EDIT)) {
+        int cell = at(position) & UNDO_CELL_MASK;
+        put(cell / MAP_HEIGHT, cell % MAP_HEIGHT, tile);
+        position++;
+    }
+    _cursor = position;
+    return true;
+}
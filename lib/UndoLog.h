@@ -0,0 +1,65 @@
+#ifndef UNDOLOG_H
+#define UNDOLOG_H
+
+#include "mbed.h"
+#include "Arena.h"
+#include "TileMap.h"
+
+static_assert(MAP_WIDTH * MAP_HEIGHT <= 512 && TILE_TYPE_COUNT <= 16,
+              "a change is the tile's index in 9 bits and what it was in 4");
+
+/** UndoLog Class
+@brief Undo and redo for tile edits, in a fixed ring of 16-bit entries
+
+An edit, whether one dab of paint or a fill of the whole map, is a marker
+entry holding the tile it sets followed by one entry per tile it changed,
+holding where the tile is and what it was before. Undo puts the old tiles
+back. Redo sets them to the marker's tile again. Starting a new edit drops
+anything that could still be redone.
+
+The ring never grows: when it is full the oldest edits are forgotten whole.
+An edit too big for the ring on its own clears the history and is not
+undoable, so size the ring at more than the map has tiles to avoid that.
+
+Example:
+
+@code
+
+log.begin(TILE_WALL);
+for each tile to change:
+    log.record(x, y, map.get(x, y));
+    map.set(x, y, TILE_WALL);
+log.end();
+...
+log.undo(callback(this, &Editor::putTile));
+
+@endcode
+*/
+class UndoLog
+{
+public:
+    UndoLog();
+
+    void init(Arena &arena, int entries);
+    void clear();
+
+    void begin(uint8_t tile);                  // an edit that sets tiles to tile
+    void record(int x, int y, uint8_t old);    // a tile it is about to change
+    void end();
+
+    bool undo(Callback<void(int, int, uint8_t)> put);  // false if there is nothing to undo
+    bool redo(Callback<void(int, int, uint8_t)> put);
+
+private:
+    uint16_t &at(uint32_t position);
+    void push(uint16_t entry);
+
+    uint16_t *_entries;
+    uint32_t _capacity;
+    uint32_t _start, _end;  // positions held, counting up for ever
+    uint32_t _cursor;       // where undo goes back from and redo goes on from
+    uint32_t _edit;         // the marker of the edit being recorded
+    bool _overflow;         // it outgrew the ring
+};
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdint.h>
+
 struct Position2D {
   int x;
   int y;  
@@ -23,6 +25,18 @@ struct UserInput {
     float mag;
 };
 
+// Button bits used in InputFrame::buttons
+#define BUTTON_JOY    0x01  // joystick push button
+#define BUTTON_SELECT 0x02  // board select button
+
+// One frame of input as the games see it. mag is the joystick magnitude
+// quantised to 0-15 so ADC noise doesn't make every frame look different.
+struct InputFrame {
+    Direction d;
+    uint8_t mag;
+    uint8_t buttons;
+};
+
 struct Vector2D {
   float x;
   float y;  
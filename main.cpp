@@ -1,43 +1,55 @@
 #include "mbed.h"
+#include "Log.h"
 #include "N5110.h"
 #include "Joystick.h"
+#include "InputSource.h"
+#include "FramePipeline.h"
+#include "SceneManager.h"
 #include "menu.h"
 #include "games.h"
 #include "MapEditor.h"
+#include "MapStore.h"
+#include "FlashIAP/FlashIAPBlockDevice.h"
+#include "tdbstore/TDBStore.h"
 
 N5110 lcd(PC_7, PA_9, PB_10, PB_5, PB_3, PA_10);
 Joystick joystick(PC_1, PC_0, PB_4);
 DigitalIn selectButton(BUTTON1);
+InputSource input(joystick, selectButton);
+FramePipeline pipeline(lcd, &input);
+
+// Map slots in the last 64 KB of flash: mbed_app.json pins the region for the
+// board and takes it off the application's size, so the two can't overlap
+FlashIAPBlockDevice mapFlash;
+ProfilingBlockDevice mapWear(&mapFlash);
+TDBStore mapStore(&mapWear);
+MapStore maps(mapStore, mapWear);
+
+// Every scene lives for the whole run, so switching never allocates
+SceneManager scenes(lcd, input, &pipeline);
+MenuScene menu(input);
+ExploreScene explore(input, maps);
+InvadersScene invaders(input);
+MapEditor editor(maps);
+ExitScene exitScene;
 
 int main() {
+    Log::start();
     lcd.init(LPH7366_1);
     lcd.setContrast(0.5);
     joystick.init();
+    maps.init();
+    input.set_mode((InputSource::Mode)MBED_CONF_APP_INPUT_MODE);
+#if MBED_CONF_APP_PIPELINE
+    // input, game and display work on separate threads
+    input.start_sampler(10ms);
+    pipeline.start();
+#endif
 
-    while (true) {
-        // Show main menu to choose game mode or exit
-        showMainMenu(lcd, joystick, selectButton);
-        if (selected == 0) {
-            // Mars Exploration game
-            exploreMap(lcd, joystick, selectButton);
-        } else if (selected == 1) {
-            // Space Invade game
-            spaceInvadeGame(lcd, joystick, selectButton);
-        } 
-          else if (selected == 2) {
-            MapEditor editor(lcd, joystick, selectButton);
-            editor.run();
-        }
-        
-        else {
-            // Exit option
-            lcd.clear();
-            lcd.printString("Exiting...", 0, 3);
-            lcd.refresh();
-            ThisThread::sleep_for(2000ms);
-            while (true) { 
-                ThisThread::sleep_for(1000ms); 
-            }
-        }
-    }
-}
\ No newline at end of file
+    scenes.add(SCENE_MENU, menu);
+    scenes.add(SCENE_EXPLORE, explore);
+    scenes.add(SCENE_INVADERS, invaders);
+    scenes.add(SCENE_EDITOR, editor);
+    scenes.add(SCENE_EXIT, exitScene);
+    scenes.run(SCENE_MENU);
+}
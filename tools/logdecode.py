@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+"""Decode the binary log records sent by lib/Log.cpp.
+
+The console carries ordinary printf text mixed with framed log records:
+
+    0xA5, length, id (2), level << 4 | count, time us (4), args (4 each), checksum
+
+Text is passed through unchanged; records are looked up in lib/LogFormats.h
+and printed as "time level tag: message".
+
+    python3 tools/logdecode.py capture.bin
+    python3 tools/logdecode.py --port /dev/ttyACM0      (needs pyserial)
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+LEVELS = {1: "ERROR", 2: "WARN", 3: "INFO", 4: "DEBUG", 5: "TRACE"}
+DEFAULT_FORMATS = os.path.join(os.path.dirname(__file__), "..", "lib", "LogFormats.h")
+
+
+def load_formats(path):
+    """Entries of the LOG_FORMATS X-macro, in ID order."""
+    with open(path) as f:
+        text = f.read()
+    entries = re.findall(r'X\(\s*(\w+)\s*,\s*"([^"]*)"\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', text)
+    return [(name, tag, fmt) for name, tag, fmt in entries]
+
+
+def format_message(fmt, args):
+    """printf-style substitution of the raw 32-bit arguments."""
+    values = iter(args)
+
+    def conv(match):
+        spec = match.group(1)
+        if spec == "%":
+            return "%"
+        value = next(values, 0)
+        if spec == "u":
+            return str(value & 0xFFFFFFFF)
+        if spec in "xX":
+            return format(value & 0xFFFFFFFF, spec)
+        return str(value)
+
+    return re.sub(r"%([diuxX%])", conv, fmt)
+
+
+def decode(stream, formats, out):
+    """Reads bytes from stream until it ends, writing text and records to out."""
+    text = bytearray()
+    buf = bytearray()
+
+    def flush_text():
+        if text:
+            out.write(text.decode("ascii", "replace"))
+            text.clear()
+
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        buf.extend(chunk)
+        while buf:
+            if buf[0] != SYNC:
+                text.append(buf.pop(0))
+                continue
+            if len(buf) < 2 or len(buf) < buf[1] + 3:
+                break  # wait for the rest of the frame
+            length = buf[1]
+            payload = bytes(buf[2:2 + length])
+            checksum = buf[2 + length]
+            if length < 7 or (sum(payload) & 0xFF) != checksum:
+                text.append(buf.pop(0))  # not a record after all
+                continue
+            del buf[:3 + length]
+            flush_text()
+
+            ident, info, time_us = struct.unpack_from("<HBI", payload)
+            count = info & 0x0F
+            args = struct.unpack_from("<%di" % count, payload, 7)
+            level = LEVELS.get(info >> 4, "?")
+            if ident < len(formats):
+                _, tag, fmt = formats[ident]
+                message = format_message(fmt, args)
+            else:
+                tag, message = "?", "unknown id %d %s" % (ident, list(args))
+            out.write("%10.3f %-5s %s: %s\n" % (time_us / 1e6, level, tag, message))
+        flush_text()
+        out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("capture", nargs="?", help="raw capture of the serial output")
+    parser.add_argument("--port", help="read live from a serial port instead")
+    parser.add_argument("--baud", type=int, default=9600)
+    parser.add_argument("--formats", default=DEFAULT_FORMATS, help="path to LogFormats.h")
+    args = parser.parse_args()
+
+    formats = load_formats(args.formats)
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baud)
+    elif args.capture:
+        stream = open(args.capture, "rb")
+    else:
+        stream = sys.stdin.buffer
+    decode(stream, formats, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
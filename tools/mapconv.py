@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""Convert map editor maps between the binary format and source forms.
+
+The binary format (lib/MapCodec.h) is
+
+    "MXM1", uint16 width, uint8 height, uint8 tileset,
+    runs of (length - 1) << 4 | tile in row order, uint32 CRC-32
+
+and travels over the console in frames (lib/MapLink.h):
+
+    0x5A, type, seq, length, payload, checksum
+
+Source forms are the C array the editor used to print, int map[H][W] = {...},
+and level art as used by constexpr levels (Map/levels.cpp).
+
+    python3 tools/mapconv.py decode capture.bin --art      frames or .mxm -> source
+    python3 tools/mapconv.py encode level.txt -o map.mxm   art or C array -> .mxm
+    python3 tools/mapconv.py receive --port /dev/ttyACM0 -o map.mxm
+    python3 tools/mapconv.py send map.mxm --port /dev/ttyACM0
+
+receive and send need pyserial; receive waits for a long press of select in
+the editor, send replaces the map open in the editor.
+"""
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = b"MXM1"
+TILESET = 1
+TILE_CHARS = ".#HROT"
+SYNC = 0x5A
+PAYLOAD = 32
+DATA, END, ACK, NAK = 1, 2, 3, 4
+
+
+def encode(grid):
+    height, width = len(grid), len(grid[0])
+    out = bytearray(MAGIC + struct.pack("<HBB", width, height, TILESET))
+    tiles = [t for row in grid for t in row]
+    i = 0
+    while i < len(tiles):
+        run = 1
+        while i + run < len(tiles) and run < 16 and tiles[i + run] == tiles[i]:
+            run += 1
+        out.append((run - 1) << 4 | tiles[i])
+        i += run
+    out += struct.pack("<I", zlib.crc32(bytes(out)) & 0xFFFFFFFF)
+    return bytes(out)
+
+
+def decode(data):
+    if data[:4] != MAGIC:
+        sys.exit("not a map: bad magic")
+    width, height, tileset = struct.unpack_from("<HBB", data, 4)
+    if tileset != TILESET:
+        sys.exit("map uses tileset %d, expected %d" % (tileset, TILESET))
+    tiles = []
+    i = 8
+    while len(tiles) < width * height:
+        if i >= len(data):
+            sys.exit("map ends early")
+        tiles += [data[i] & 0x0F] * ((data[i] >> 4) + 1)
+        i += 1
+    if len(tiles) != width * height:
+        sys.exit("runs overflow the map")
+    (crc,) = struct.unpack_from("<I", data, i)
+    if crc != zlib.crc32(data[:i]) & 0xFFFFFFFF:
+        sys.exit("CRC mismatch")
+    return [tiles[y * width:(y + 1) * width] for y in range(height)]
+
+
+def frame(kind, seq, payload=b""):
+    body = bytes([kind, seq & 0xFF, len(payload)]) + payload
+    return bytes([SYNC]) + body + bytes([sum(body) & 0xFF])
+
+
+def read_frames(data):
+    """(type, seq, payload) of every valid frame in a capture, skipping other text."""
+    frames = []
+    i = 0
+    while i + 5 <= len(data):
+        length = data[i + 3]
+        end = i + 5 + length
+        if data[i] != SYNC or length > PAYLOAD or end > len(data) or \
+                sum(data[i + 1:end - 1]) & 0xFF != data[end - 1]:
+            i += 1
+            continue
+        frames.append((data[i + 1], data[i + 2], data[i + 4:end - 1]))
+        i = end
+    return frames
+
+
+def unframe(data):
+    """The last map sent in a capture, or the data itself if it is a bare map."""
+    if data[:4] == MAGIC:
+        return data
+    payload = bytearray()
+    result = None
+    for kind, seq, body in read_frames(data):
+        if kind == DATA:
+            if seq == 0:
+                payload = bytearray()
+            payload += body
+        elif kind == END:
+            result = bytes(payload)
+    if result is None:
+        sys.exit("no complete map in the capture")
+    return result
+
+
+def parse_source(text):
+    """Level art rows or a C int array."""
+    rows = re.findall(r"\{([\d,\s]+)\}", text)
+    if rows:
+        return [[int(v) for v in row.split(",") if v.strip()] for row in rows]
+    rows = re.findall(r'"([^"]*)"', text) or [l.strip() for l in text.splitlines() if l.strip()]
+    try:
+        return [[TILE_CHARS.index(c) for c in row] for row in rows]
+    except ValueError as e:
+        sys.exit("unknown tile character: %s" % e)
+
+
+def to_array(grid):
+    lines = ["int map[%d][%d] = {" % (len(grid), len(grid[0]))]
+    for y, row in enumerate(grid):
+        lines.append("  {%s}%s" % (",".join(str(t) for t in row), "," if y < len(grid) - 1 else ""))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def to_art(grid):
+    lines = ["constexpr char LEVEL_ART[MAP_HEIGHT][MAP_WIDTH + 1] = {"]
+    lines += ['    "%s",' % "".join(TILE_CHARS[t] for t in row) for row in grid]
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def open_port(args):
+    import serial
+    return serial.Serial(args.port, args.baud, timeout=2)
+
+
+def receive(args):
+    port = open_port(args)
+    data = bytearray()
+    print("waiting for an export from the editor...", file=sys.stderr)
+    while not any(kind == END for kind, _, _ in read_frames(data)):
+        data += port.read(64)
+    return unframe(bytes(data))
+
+
+def send(args, data):
+    port = open_port(args)
+    chunks = [data[i:i + PAYLOAD] for i in range(0, len(data), PAYLOAD)]
+    frames = [frame(DATA, seq, chunk) for seq, chunk in enumerate(chunks)]
+    frames.append(frame(END, len(chunks)))
+    for seq, f in enumerate(frames):
+        for attempt in range(3):
+            port.write(f)
+            reply = bytearray()
+            answer = None
+            while answer is None:
+                byte = port.read(1)
+                if not byte:
+                    break
+                reply += byte
+                for kind, rseq, _ in read_frames(reply):
+                    if kind in (ACK, NAK) and rseq == seq & 0xFF:
+                        answer = kind
+            if answer == ACK:
+                break
+            if answer == NAK and seq == len(frames) - 1:
+                sys.exit("the editor refused the map")
+        else:
+            sys.exit("no answer from the editor for frame %d" % seq)
+    print("sent %d bytes in %d frames" % (len(data), len(frames)), file=sys.stderr)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("command", choices=["decode", "encode", "receive", "send"])
+    parser.add_argument("input", nargs="?", help="capture/.mxm to decode, source to encode, .mxm to send")
+    parser.add_argument("-o", "--output", help="write here instead of stdout")
+    parser.add_argument("--art", action="store_true", help="decode to level art instead of a C array")
+    parser.add_argument("--port", help="serial port for receive and send")
+    parser.add_argument("--baud", type=int, default=9600)
+    args = parser.parse_args()
+
+    if args.command in ("receive", "send") and not args.port:
+        sys.exit("%s needs --port" % args.command)
+
+    if args.command == "send":
+        with open(args.input, "rb") as f:
+            send(args, unframe(f.read()))
+        return
+
+    if args.command == "encode":
+        with open(args.input) as f:
+            out = encode(parse_source(f.read()))
+    else:
+        if args.command == "receive":
+            data = receive(args)
+        else:
+            with open(args.input, "rb") as f:
+                data = unframe(f.read())
+        decode(data)  # check it before writing anything
+        if args.output and args.output.endswith(".mxm"):
+            out = data
+        else:
+            grid = decode(data)
+            out = (to_art(grid) if args.art else to_array(grid)) + "\n"
+
+    if isinstance(out, str):
+        out = out.encode()
+    if args.output:
+        with open(args.output, "wb") as f:
+            f.write(out)
+    else:
+        sys.stdout.buffer.write(out)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Pack a text level into the chunked world format read by lib/ChunkSource.cpp.
+
+The level is MAP_HEIGHT (8) lines of equal length, one character per tile:
+
+    .  empty     #  wall      H  habitat
+    R  rover     O  crater    T  terminal
+
+It is cut into 16-column chunks (a short last chunk is padded with wall),
+each compressed as one byte per run: (length - 1) << 4 | tile. The output is
+
+    "MXW1", uint32 count, uint32 offset[count + 1], chunks...
+
+little-endian, written as a binary file (for a block device, or a file on
+the host) and/or a C++ source file to link the world into flash.
+
+    python3 tools/worldpack.py Map/mars.txt --cpp Map/marsWorld.cpp --name MARS_WORLD
+    python3 tools/worldpack.py Map/mars.txt --bin mars.mxw
+"""
+
+import argparse
+import struct
+import sys
+
+HEIGHT = 8
+CHUNK_WIDTH = 16
+TILES = {".": 0, "#": 1, "H": 2, "R": 3, "O": 4, "T": 5}
+
+
+def read_level(path):
+    with open(path) as f:
+        rows = [line.rstrip("\n") for line in f if line.strip()]
+    if len(rows) != HEIGHT:
+        sys.exit("%s: %d rows, expected %d" % (path, len(rows), HEIGHT))
+    width = max(len(row) for row in rows)
+    width += -width % CHUNK_WIDTH
+    grid = []
+    for y, row in enumerate(rows):
+        try:
+            grid.append([TILES[c] for c in row.ljust(width, "#")])
+        except KeyError as e:
+            sys.exit("%s: unknown tile %s in row %d" % (path, e, y))
+    return grid, width
+
+
+def encode_chunk(grid, x0):
+    """Runs over the chunk's tiles in row order."""
+    tiles = [grid[y][x] for y in range(HEIGHT) for x in range(x0, x0 + CHUNK_WIDTH)]
+    out = bytearray()
+    i = 0
+    while i < len(tiles):
+        run = 1
+        while i + run < len(tiles) and run < 16 and tiles[i + run] == tiles[i]:
+            run += 1
+        out.append((run - 1) << 4 | tiles[i])
+        i += run
+    return bytes(out)
+
+
+def pack(grid, width):
+    chunks = [encode_chunk(grid, x) for x in range(0, width, CHUNK_WIDTH)]
+    offset = 8 + 4 * (len(chunks) + 1)
+    offsets = []
+    for chunk in chunks:
+        offsets.append(offset)
+        offset += len(chunk)
+    offsets.append(offset)
+    header = b"MXW1" + struct.pack("<I", len(chunks)) + struct.pack("<%dI" % len(offsets), *offsets)
+    return header + b"".join(chunks)
+
+
+def write_cpp(path, name, source, data, width):
+    with open(path, "w") as f:
+        f.write("// Generated by tools/worldpack.py from %s - edit that and regenerate\n" % source)
+        f.write("// %d columns in %d chunks, %d bytes\n\n" % (width, width // CHUNK_WIDTH, len(data)))
+        f.write('#include "mbed.h"\n\n')
+        f.write("extern const uint8_t %s[] = {\n" % name)
+        for i in range(0, len(data), 16):
+            f.write("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",\n")
+        f.write("};\n\n")
+        f.write("extern const size_t %s_SIZE = sizeof(%s);\n" % (name, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("level", help="text level")
+    parser.add_argument("--bin", help="write the world file here")
+    parser.add_argument("--cpp", help="write a C++ array here")
+    parser.add_argument("--name", default="WORLD", help="array name for --cpp")
+    args = parser.parse_args()
+
+    grid, width = read_level(args.level)
+    data = pack(grid, width)
+    if args.bin:
+        with open(args.bin, "wb") as f:
+            f.write(data)
+    if args.cpp:
+        write_cpp(args.cpp, args.name, args.level.split("/")[-1], data, width)
+    print("%d columns, %d chunks, %d bytes (%d tiles)" % (width, width // CHUNK_WIDTH, len(data), width * HEIGHT))
+
+
+if __name__ == "__main__":
+    main()